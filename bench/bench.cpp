@@ -0,0 +1,515 @@
+//===-- bench/bench.cpp ---------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Throughput benchmarks for runtime kernels.  Usage:
+//   bench <name> [sizes...]
+// with no name, every benchmark runs with its default sizes.  Each result
+// is the best of several repetitions.  Environment variables such as
+// FORT_NUM_THREADS apply as they do to a Fortran program.
+
+#include "environment.h"
+#include "flang/Runtime/descriptor.h"
+#include "flang/Runtime/main.h"
+#include "flang/Runtime/matmul.h"
+#include "flang/Runtime/reduction.h"
+#include "flang/Runtime/transformational.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+using namespace Fortran::runtime;
+using Fortran::common::TypeCategory;
+
+namespace {
+
+// Seconds taken by the fastest of `reps` calls of f().
+template <typename F> double BestTime(int reps, F &&f) {
+  double best{1e30};
+  for (int j{0}; j < reps; ++j) {
+    auto start{std::chrono::steady_clock::now()};
+    f();
+    std::chrono::duration<double> elapsed{
+        std::chrono::steady_clock::now() - start};
+    best = std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+template <typename T> struct Scalar {
+  using Part = T;
+  static constexpr TypeCategory category{TypeCategory::Real};
+};
+template <> struct Scalar<std::int32_t> {
+  using Part = std::int32_t;
+  static constexpr TypeCategory category{TypeCategory::Integer};
+};
+template <typename T> struct Scalar<std::complex<T>> {
+  using Part = T;
+  static constexpr TypeCategory category{TypeCategory::Complex};
+};
+
+// Values in [-1, 1].
+template <typename T> std::vector<T> RandomValues(std::size_t n) {
+  using Part = typename Scalar<T>::Part;
+  std::vector<T> values(n);
+  unsigned state{12345};
+  auto next{[&]() {
+    state = state * 1103515245u + 12345u;
+    return static_cast<Part>((state >> 8) % 2001) / Part{1000} - Part{1};
+  }};
+  for (auto &x : values) {
+    if constexpr (std::is_same_v<T, Part>) {
+      x = next();
+    } else {
+      Part re{next()};
+      x = T{re, next()};
+    }
+  }
+  return values;
+}
+
+// A column-major matrix or vector descriptor over existing storage.
+template <typename T>
+OwningPtr<Descriptor> Describe(T *data, SubscriptValue rows,
+    SubscriptValue cols = 0) {
+  SubscriptValue extent[2]{rows, cols};
+  return Descriptor::Create(Scalar<T>::category,
+      sizeof(typename Scalar<T>::Part), data, cols > 0 ? 2 : 1, extent);
+}
+
+// An array descriptor of any rank over existing storage.
+template <typename T>
+OwningPtr<Descriptor> Describe(T *data, const std::vector<long> &shape) {
+  SubscriptValue extent[maxRank];
+  std::copy(shape.begin(), shape.end(), extent);
+  return Descriptor::Create(Scalar<T>::category,
+      sizeof(typename Scalar<T>::Part), data, shape.size(), extent);
+}
+
+// MATMUL: the runtime's kernel against the k-j-i loop that it used before
+// the blocked kernel, which is still the fallback for other types.
+template <typename T>
+void OldMatrixTimesMatrix(T *__restrict product, SubscriptValue rows,
+    SubscriptValue cols, const T *__restrict x, const T *__restrict y,
+    SubscriptValue n) {
+  std::fill(product, product + rows * cols, T{0});
+  for (SubscriptValue k{0}; k < n; ++k) {
+    T *__restrict p{product};
+    for (SubscriptValue j{0}; j < cols; ++j) {
+      const T *__restrict xp{x + k * rows};
+      T yv{y[k + j * n]};
+      for (SubscriptValue i{0}; i < rows; ++i) {
+        *p++ += *xp++ * yv;
+      }
+    }
+  }
+}
+
+template <typename T>
+void BenchMatmulShape(
+    const char *type, SubscriptValue m, SubscriptValue k, SubscriptValue n) {
+  auto x{RandomValues<T>(m * k)}, y{RandomValues<T>(k * n)};
+  std::vector<T> old(m * n);
+  auto xDesc{Describe(x.data(), m, k)}, yDesc{Describe(y.data(), k, n)};
+  StaticDescriptor<2> resultStatic;
+  Descriptor &result{resultStatic.descriptor()};
+  auto *matmul{[]() {
+    if constexpr (std::is_same_v<T, float>) {
+      return RTNAME(MatmulReal4Real4);
+    } else if constexpr (std::is_same_v<T, double>) {
+      return RTNAME(MatmulReal8Real8);
+    } else {
+      return RTNAME(MatmulComplex8Complex8);
+    }
+  }()};
+  // A complex multiply-add is eight real operations.
+  double flops{(std::is_same_v<T, typename Scalar<T>::Part> ? 2.0 : 8.0) * m *
+      k * n};
+  int reps{std::max(1, std::min(5, static_cast<int>(2e9 / flops)))};
+  double newTime{BestTime(reps, [&]() {
+    matmul(result, *xDesc, *yDesc, __FILE__, __LINE__);
+    if (result.IsAllocated()) {
+      result.Deallocate();
+    }
+  })};
+  double oldTime{BestTime(reps, [&]() {
+    OldMatrixTimesMatrix(old.data(), m, n, x.data(), y.data(), k);
+  })};
+  matmul(result, *xDesc, *yDesc, __FILE__, __LINE__);
+  double error{0};
+  const T *product{result.OffsetElement<T>()};
+  for (SubscriptValue j{0}; j < m * n; ++j) {
+    error = std::max(error, static_cast<double>(std::abs(product[j] - old[j])));
+  }
+  result.Deallocate();
+  std::printf("matmul %-10s %6jd x %6jd x %6jd  old %8.2f GFLOP/s  "
+              "new %8.2f GFLOP/s  %6.1fx  max diff %.1e\n",
+      type, static_cast<std::intmax_t>(m), static_cast<std::intmax_t>(k),
+      static_cast<std::intmax_t>(n), flops / oldTime * 1e-9,
+      flops / newTime * 1e-9, oldTime / newTime, error);
+}
+
+// Square sizes from the arguments, then tall-skinny shapes.
+void BenchMatmul(const std::vector<long> &sizes) {
+  std::vector<long> square{sizes};
+  if (square.empty()) {
+    square = {64, 256, 1000, 2000};
+  }
+  for (long s : square) {
+    BenchMatmulShape<double>("REAL(8)", s, s, s);
+    BenchMatmulShape<float>("REAL(4)", s, s, s);
+    BenchMatmulShape<std::complex<double>>("COMPLEX(8)", s, s, s);
+  }
+  if (sizes.empty()) {
+    BenchMatmulShape<double>("REAL(8)", 100000, 32, 32);
+    BenchMatmulShape<double>("REAL(8)", 2000, 2000, 16);
+    BenchMatmulShape<double>("REAL(8)", 16, 2000, 2000);
+  }
+}
+
+// DOT_PRODUCT: elements per nanosecond with left-to-right summation and
+// with the multiple partial sums of FORT_REORDER_SUMS=1.
+template <typename T> T DotProduct(const Descriptor &x, const Descriptor &y) {
+  if constexpr (std::is_same_v<T, float>) {
+    return RTNAME(DotProductReal4)(x, y, __FILE__, __LINE__);
+  } else if constexpr (std::is_same_v<T, double>) {
+    return RTNAME(DotProductReal8)(x, y, __FILE__, __LINE__);
+  } else {
+    T result;
+    if constexpr (std::is_same_v<T, std::complex<float>>) {
+      RTNAME(CppDotProductComplex4)(result, x, y, __FILE__, __LINE__);
+    } else {
+      RTNAME(CppDotProductComplex8)(result, x, y, __FILE__, __LINE__);
+    }
+    return result;
+  }
+}
+
+template <typename T> void BenchDotProductSize(const char *type, long n) {
+  auto x{RandomValues<T>(n)}, y{RandomValues<T>(n)};
+  auto xDesc{Describe(x.data(), n)}, yDesc{Describe(y.data(), n)};
+  // Repeat short products so that each timing covers 10^7 elements.
+  long calls{std::max(1L, 10000000 / n)};
+  double rate[2];
+  for (int reorder{0}; reorder < 2; ++reorder) {
+    executionEnvironment.reorderSums = reorder != 0;
+    double time{BestTime(5, [&]() {
+      for (long j{0}; j < calls; ++j) {
+        DotProduct<T>(*xDesc, *yDesc);
+      }
+    })};
+    rate[reorder] = n * calls / time * 1e-9;
+  }
+  executionEnvironment.reorderSums = false;
+  std::printf("dot %-10s n=%-10jd %7.2f -> %7.2f elements/ns\n", type,
+      static_cast<std::intmax_t>(n), rate[0], rate[1]);
+}
+
+void BenchDotProduct(const std::vector<long> &sizes) {
+  std::vector<long> lengths{sizes};
+  if (lengths.empty()) {
+    lengths = {16, 256, 4096, 65536, 1000000, 10000000};
+  }
+  for (long n : lengths) {
+    BenchDotProductSize<float>("REAL(4)", n);
+    BenchDotProductSize<double>("REAL(8)", n);
+    BenchDotProductSize<std::complex<float>>("COMPLEX(4)", n);
+    BenchDotProductSize<std::complex<double>>("COMPLEX(8)", n);
+  }
+}
+
+// Summation methods: for each one, the relative error of SUM against a
+// long double reference, and elements per nanosecond for SUM, DOT_PRODUCT,
+// and NORM2.  The terms lie in [0, 2], so that the exact sum is
+// well-conditioned and the error reflects the method alone.
+template <typename T> T Sum(const Descriptor &x) {
+  if constexpr (std::is_same_v<T, float>) {
+    return RTNAME(SumReal4)(x, __FILE__, __LINE__);
+  } else {
+    return RTNAME(SumReal8)(x, __FILE__, __LINE__);
+  }
+}
+
+template <typename T> T Norm2(const Descriptor &x) {
+  if constexpr (std::is_same_v<T, float>) {
+    return RTNAME(Norm2_4)(x, __FILE__, __LINE__);
+  } else {
+    return RTNAME(Norm2_8)(x, __FILE__, __LINE__);
+  }
+}
+
+template <typename T> void BenchSummationSize(const char *type, long n) {
+  auto x{RandomValues<T>(n)};
+  long double exact{0};
+  for (T &term : x) {
+    term += T{1};
+    exact += term;
+  }
+  auto xDesc{Describe(x.data(), n)};
+  long calls{std::max(1L, 10000000 / n)};
+  auto rate{[&](auto reduce) {
+    double time{BestTime(3, [&]() {
+      for (long j{0}; j < calls; ++j) {
+        reduce();
+      }
+    })};
+    return n * calls / time * 1e-9;
+  }};
+  static constexpr struct {
+    Summation summation;
+    const char *name;
+  } methods[]{{Summation::Naive, "naive"}, {Summation::Kahan, "Kahan"},
+      {Summation::Pairwise, "pairwise"}};
+  for (const auto &method : methods) {
+    Summation previous{RTNAME(SetSummation)(method.summation)};
+    long double sum{Sum<T>(*xDesc)};
+    double error{static_cast<double>(std::abs((sum - exact) / exact))};
+    double sumRate{rate([&]() { Sum<T>(*xDesc); })};
+    double dotRate{rate([&]() { DotProduct<T>(*xDesc, *xDesc); })};
+    double norm2Rate{rate([&]() { Norm2<T>(*xDesc); })};
+    RTNAME(SetSummation)(previous);
+    std::printf("summation %-8s n=%-10jd %-8s SUM error %7.1e  SUM %6.2f  "
+                "DOT_PRODUCT %6.2f  NORM2 %6.2f elements/ns\n",
+        type, static_cast<std::intmax_t>(n), method.name, error, sumRate,
+        dotRate, norm2Rate);
+  }
+}
+
+void BenchSummation(const std::vector<long> &sizes) {
+  std::vector<long> lengths{sizes};
+  if (lengths.empty()) {
+    lengths = {1000, 1000000, 10000000};
+  }
+  for (long n : lengths) {
+    BenchSummationSize<float>("REAL(4)", n);
+    BenchSummationSize<double>("REAL(8)", n);
+  }
+}
+
+// MINVAL, MAXVAL, SUM, and NORM2 of one REAL(8) array: milliseconds for
+// the separate intrinsics against one MinMaxSumNorm2Real8 call, and the
+// same for the first three with MASK=, which NORM2 lacks.
+void BenchStatisticsSize(long n) {
+  auto x{RandomValues<double>(n)};
+  std::vector<std::int32_t> mask(n);
+  for (long j{0}; j < n; ++j) {
+    mask[j] = x[j] > -0.5;
+  }
+  auto xDesc{Describe(x.data(), n)};
+  SubscriptValue extent[1]{n};
+  OwningPtr<Descriptor> maskDesc{
+      Descriptor::Create(TypeCategory::Logical, 4, mask.data(), 1, extent)};
+  double minval, maxval, sum, norm2;
+  auto time{[](auto f) { return 1e3 * BestTime(5, f); }};
+  double separate{time([&]() {
+    minval = RTNAME(MinvalReal8)(*xDesc, __FILE__, __LINE__);
+    maxval = RTNAME(MaxvalReal8)(*xDesc, __FILE__, __LINE__);
+    sum = RTNAME(SumReal8)(*xDesc, __FILE__, __LINE__);
+    norm2 = RTNAME(Norm2_8)(*xDesc, __FILE__, __LINE__);
+  })};
+  double fused{time([&]() {
+    RTNAME(MinMaxSumNorm2Real8)
+    (&minval, &maxval, &sum, &norm2, *xDesc, __FILE__, __LINE__);
+  })};
+  double maskedSeparate{time([&]() {
+    const Descriptor *m{maskDesc.get()};
+    minval = RTNAME(MinvalReal8)(*xDesc, __FILE__, __LINE__, 0, m);
+    maxval = RTNAME(MaxvalReal8)(*xDesc, __FILE__, __LINE__, 0, m);
+    sum = RTNAME(SumReal8)(*xDesc, __FILE__, __LINE__, 0, m);
+  })};
+  double maskedFused{time([&]() {
+    RTNAME(MinMaxSumNorm2Real8)
+    (&minval, &maxval, &sum, nullptr, *xDesc, __FILE__, __LINE__,
+        maskDesc.get());
+  })};
+  std::printf("statistics n=%-10jd  4 calls %8.3f  fused %8.3f ms  %5.2fx  "
+              "MASK= 3 calls %8.3f  fused %8.3f ms  %5.2fx\n",
+      static_cast<std::intmax_t>(n), separate, fused, separate / fused,
+      maskedSeparate, maskedFused, maskedSeparate / maskedFused);
+}
+
+void BenchStatistics(const std::vector<long> &sizes) {
+  std::vector<long> lengths{sizes};
+  if (lengths.empty()) {
+    lengths = {10000, 1000000, 50000000};
+  }
+  for (long n : lengths) {
+    BenchStatisticsSize(n);
+  }
+}
+
+// TRANSPOSE: the runtime's blocked copy against the per-element loop that
+// it replaced, which walks the result in array element order and copies
+// each element from its address in the source.
+void OldTranspose(const Descriptor &result, const Descriptor &matrix) {
+  std::size_t bytes{matrix.ElementBytes()};
+  SubscriptValue resultAt[2]{1, 1};
+  for (std::size_t n{result.Elements()}; n-- > 0;
+       result.IncrementSubscripts(resultAt)) {
+    SubscriptValue matrixAt[2]{resultAt[1], resultAt[0]};
+    std::memcpy(result.Element<char>(resultAt),
+        matrix.Element<const char>(matrixAt), bytes);
+  }
+}
+
+template <typename T>
+void BenchTransposeShape(const char *type, SubscriptValue rows,
+    SubscriptValue cols) {
+  auto x{RandomValues<T>(rows * cols)};
+  std::vector<T> old(rows * cols);
+  auto xDesc{Describe(x.data(), rows, cols)};
+  auto oldDesc{Describe(old.data(), cols, rows)};
+  StaticDescriptor<2> resultStatic;
+  Descriptor &result{resultStatic.descriptor()};
+  double newTime{BestTime(3, [&]() {
+    RTNAME(Transpose)(result, *xDesc, __FILE__, __LINE__);
+    result.Deallocate();
+  })};
+  double oldTime{BestTime(3, [&]() { OldTranspose(*oldDesc, *xDesc); })};
+  RTNAME(Transpose)(result, *xDesc, __FILE__, __LINE__);
+  bool same{std::memcmp(result.OffsetElement(), old.data(),
+                rows * cols * sizeof(T)) == 0};
+  result.Deallocate();
+  // Each element is read once and written once.
+  double bytes{2.0 * sizeof(T) * rows * cols};
+  std::printf("transpose %-10s %6jd x %6jd  old %7.2f GB/s  new %7.2f GB/s  "
+              "%6.1fx%s\n",
+      type, static_cast<std::intmax_t>(rows), static_cast<std::intmax_t>(cols),
+      bytes / oldTime * 1e-9, bytes / newTime * 1e-9, oldTime / newTime,
+      same ? "" : "  MISMATCH");
+}
+
+// Square sizes from the arguments, then 8192 x 8192 REAL(8).
+void BenchTranspose(const std::vector<long> &sizes) {
+  std::vector<long> square{sizes};
+  if (square.empty()) {
+    square = {1000, 4096};
+  }
+  for (long s : square) {
+    BenchTransposeShape<float>("REAL(4)", s, s);
+    BenchTransposeShape<double>("REAL(8)", s, s);
+    BenchTransposeShape<std::complex<double>>("COMPLEX(8)", s, s);
+  }
+  if (sizes.empty()) {
+    BenchTransposeShape<double>("REAL(8)", 8192, 8192);
+    BenchTransposeShape<double>("REAL(8)", 100000, 16);
+  }
+}
+
+// Partial reductions with DIM=: milliseconds for each DIM of rank-3
+// arrays, for SUM of REAL(8) and INTEGER(4), MAXVAL of REAL(4), and SUM of
+// REAL(8) with MASK=.
+void BenchReduceDimShape(const std::vector<long> &shape) {
+  std::size_t n{1};
+  for (long extent : shape) {
+    n *= extent;
+  }
+  auto r8{RandomValues<double>(n)};
+  auto r4{RandomValues<float>(n)};
+  auto i4{RandomValues<std::int32_t>(n)};
+  std::vector<std::int32_t> mask(n);
+  for (std::size_t j{0}; j < n; ++j) {
+    mask[j] = r8[j] > -0.5;
+  }
+  auto r8Desc{Describe(r8.data(), shape)}, r4Desc{Describe(r4.data(), shape)};
+  auto i4Desc{Describe(i4.data(), shape)};
+  SubscriptValue extent[maxRank];
+  std::copy(shape.begin(), shape.end(), extent);
+  OwningPtr<Descriptor> maskDesc{Descriptor::Create(
+      TypeCategory::Logical, 4, mask.data(), shape.size(), extent)};
+  StaticDescriptor<maxRank> resultStatic;
+  Descriptor &result{resultStatic.descriptor()};
+  auto time{[&](auto reduce) {
+    return 1e3 * BestTime(3, [&]() {
+      reduce();
+      result.Deallocate();
+    });
+  }};
+  for (int dim{1}; dim <= static_cast<int>(shape.size()); ++dim) {
+    double sumR8{time([&]() {
+      RTNAME(SumDim)(result, *r8Desc, dim, __FILE__, __LINE__);
+    })};
+    double sumI4{time([&]() {
+      RTNAME(SumDim)(result, *i4Desc, dim, __FILE__, __LINE__);
+    })};
+    double maxvalR4{time([&]() {
+      RTNAME(MaxvalDim)(result, *r4Desc, dim, __FILE__, __LINE__);
+    })};
+    double maskedSumR8{time([&]() {
+      RTNAME(SumDim)(result, *r8Desc, dim, __FILE__, __LINE__, maskDesc.get());
+    })};
+    std::printf("reduce-dim %5jd x %5jd x %5jd  DIM=%d  SUM r8 %7.2f  "
+                "SUM i4 %7.2f  MAXVAL r4 %7.2f  SUM r8 MASK= %7.2f ms\n",
+        static_cast<std::intmax_t>(shape[0]),
+        static_cast<std::intmax_t>(shape[1]),
+        static_cast<std::intmax_t>(shape[2]), dim, sumR8, sumI4, maxvalR4,
+        maskedSumR8);
+  }
+}
+
+// Sizes are the three extents of one shape.
+void BenchReduceDim(const std::vector<long> &sizes) {
+  if (sizes.size() == 3) {
+    BenchReduceDimShape(sizes);
+  } else {
+    BenchReduceDimShape({200, 200, 200});
+    BenchReduceDimShape({1000, 1000, 8});
+    BenchReduceDimShape({8, 1000, 1000});
+    BenchReduceDimShape({64, 4096, 32});
+  }
+}
+
+struct Benchmark {
+  const char *name;
+  void (*run)(const std::vector<long> &);
+};
+
+const Benchmark benchmarks[]{
+    {"matmul", BenchMatmul},
+    {"dot", BenchDotProduct},
+    {"summation", BenchSummation},
+    {"statistics", BenchStatistics},
+    {"transpose", BenchTranspose},
+    {"reduce-dim", BenchReduceDim},
+};
+
+} // namespace
+
+int main(int argc, char *argv[], char *envp[]) {
+  RTNAME(ProgramStart)
+  (argc, const_cast<const char **>(argv), const_cast<const char **>(envp),
+      nullptr);
+  const char *which{argc > 1 ? argv[1] : nullptr};
+  std::vector<long> sizes;
+  for (int j{2}; j < argc; ++j) {
+    sizes.push_back(std::atol(argv[j]));
+  }
+  bool found{false};
+  for (const Benchmark &benchmark : benchmarks) {
+    if (!which || std::strcmp(which, benchmark.name) == 0) {
+      benchmark.run(sizes);
+      found = true;
+    }
+  }
+  if (!found) {
+    std::fprintf(stderr, "unknown benchmark '%s'; choose from:", which);
+    for (const Benchmark &benchmark : benchmarks) {
+      std::fprintf(stderr, " %s", benchmark.name);
+    }
+    std::fprintf(stderr, "\n");
+    return 1;
+  }
+  return 0;
+}
@@ -13,6 +13,7 @@ pub fn build(b: *std.Build) void {
     const shared = b.option(bool, "shared", "Build as shared library [default: false]") orelse false;
     const amalgamation = b.option(bool, "amalgamation", "Build as amalgamation [default: false]") orelse false;
     const tests = b.option(bool, "enable-tests", "Build tests [default: false]") orelse false;
+    const bench = b.option(bool, "enable-bench", "Build benchmarks [default: false]") orelse false;
 
     const libDec = buildFortranDecimal(b, .{
         .target = target,
@@ -50,6 +51,25 @@ pub fn build(b: *std.Build) void {
         const run_step = b.step(exe.name, b.fmt("Run {s}", .{exe.name}));
         run_step.dependOn(&run_cmd.step);
     }
+
+    if (bench) {
+        const exe = buildBench(b, exeInfo{
+            .target = target,
+            .optimize = optimize,
+            .lib = libRuntime,
+        });
+        if (!amalgamation) exe.linkLibrary(libDec);
+
+        b.installArtifact(exe);
+
+        const run_cmd = b.addRunArtifact(exe);
+        run_cmd.step.dependOn(b.getInstallStep());
+        if (b.args) |args| {
+            run_cmd.addArgs(args);
+        }
+        const run_step = b.step(exe.name, b.fmt("Run {s}", .{exe.name}));
+        run_step.dependOn(&run_cmd.step);
+    }
 }
 
 const libConfig = struct {
@@ -158,6 +178,51 @@ fn buildTest(b: *std.Build, options: exeInfo) *std.Build.Step.Compile {
         if (dir == .other_step) continue;
         exe.root_module.addIncludePath(dir.path);
     }
+    exe.root_module.addIncludePath(b.path("src/runtime"));
+    exe.root_module.addCSourceFiles(.{
+        .files = &.{
+            "tests/assign.cpp",
+            "tests/derived.cpp",
+            "tests/matmul.cpp",
+            "tests/reduction.cpp",
+            "tests/transformational.cpp",
+        },
+        .flags = &.{
+            "-Wall",
+            "-Wextra",
+            "-std=c++17",
+        },
+    });
+    exe.linkLibrary(options.lib);
+    if (exe.rootModuleTarget().abi != .msvc)
+        exe.linkLibCpp()
+    else {
+        exe.root_module.addCMacro("_CRT_SECURE_NO_WARNINGS", "");
+        exe.linkLibC();
+    }
+    return exe;
+}
+
+fn buildBench(b: *std.Build, options: exeInfo) *std.Build.Step.Compile {
+    const exe = b.addExecutable(.{
+        .name = "bench",
+        .target = options.target,
+        .optimize = options.optimize,
+    });
+    exe.root_module.addIncludePath(b.path("include"));
+    exe.root_module.addIncludePath(b.path("src/runtime"));
+    exe.root_module.addCSourceFiles(.{
+        .files = &.{"bench/bench.cpp"},
+        .flags = &.{
+            "-Wall",
+            "-Wextra",
+            "-std=c++17",
+        },
+    });
+    switch (exe.rootModuleTarget().cpu.arch.endian()) {
+        .big => exe.root_module.addCMacro("FLANG_BIG_ENDIAN", "1"),
+        .little => exe.root_module.addCMacro("FLANG_LITTLE_ENDIAN", "1"),
+    }
     exe.linkLibrary(options.lib);
     if (exe.rootModuleTarget().abi != .msvc)
         exe.linkLibCpp()
@@ -173,6 +238,7 @@ const runtime = &.{
     "src/runtime/allocatable.cpp",
     "src/runtime/array-constructor.cpp",
     "src/runtime/assign.cpp",
+    "src/runtime/blas.cpp",
     "src/runtime/buffer.cpp",
     "src/runtime/character.cpp",
     "src/runtime/command.cpp",
@@ -210,6 +276,7 @@ const runtime = &.{
     "src/runtime/namelist.cpp",
     "src/runtime/non-tbp-dio.cpp",
     "src/runtime/numeric.cpp",
+    "src/runtime/packed-mask.cpp",
     "src/runtime/pointer.cpp",
     "src/runtime/product.cpp",
     "src/runtime/pseudo-unit.cpp",
@@ -231,6 +298,7 @@ const runtime = &.{
     "src/runtime/unit-map.cpp",
     "src/runtime/unit.cpp",
     "src/runtime/utf.cpp",
+    "src/runtime/worker-pool.cpp",
 };
 
 const lib_decimal = &.{
@@ -13,10 +13,51 @@
 #include "flang/Common/float128.h"
 #include "flang/Common/uint128.h"
 #include "flang/Runtime/entry-names.h"
+#include <cstddef>
 namespace Fortran::runtime {
 class Descriptor;
 extern "C" {
 
+// External BLAS routines that MATMUL, MATMUL(TRANSPOSE()) and DOT_PRODUCT
+// may call for contiguous REAL(4) and REAL(8) operands of the same kind.
+// The routines use the reference Fortran BLAS calling convention (all
+// arguments by reference, default 32-bit integers), so that e.g. the
+// dgemm_ of OpenBLAS or MKL can be registered directly.  Any of them may be
+// null.  Operations with fewer than minimumWork multiply-adds keep using
+// the runtime's own kernels.
+struct BlasFunctions {
+  void (*sgemm)(const char *transa, const char *transb, const int *m,
+      const int *n, const int *k, const float *alpha, const float *a,
+      const int *lda, const float *b, const int *ldb, const float *beta,
+      float *c, const int *ldc);
+  void (*dgemm)(const char *transa, const char *transb, const int *m,
+      const int *n, const int *k, const double *alpha, const double *a,
+      const int *lda, const double *b, const int *ldb, const double *beta,
+      double *c, const int *ldc);
+  void (*sgemv)(const char *trans, const int *m, const int *n,
+      const float *alpha, const float *a, const int *lda, const float *x,
+      const int *incx, const float *beta, float *y, const int *incy);
+  void (*dgemv)(const char *trans, const int *m, const int *n,
+      const double *alpha, const double *a, const int *lda, const double *x,
+      const int *incx, const double *beta, double *y, const int *incy);
+  float (*sdot)(const int *n, const float *x, const int *incx, const float *y,
+      const int *incy);
+  double (*ddot)(const int *n, const double *x, const int *incx,
+      const double *y, const int *incy);
+  std::size_t minimumWork;
+};
+
+// Registers the BLAS routines to use from now on; the table is copied.
+// A null argument reverts to the runtime's own kernels.  This should be
+// called before any Fortran code that might be running MATMUL or
+// DOT_PRODUCT on another thread.
+void RTDECL(RegisterBlasFunctions)(const BlasFunctions *);
+
+// Simple in-runtime implementations of every routine in BlasFunctions
+// (minimumWork is zero), for exercising the dispatch without an external
+// BLAS library.
+const BlasFunctions *RTDECL(ReferenceBlasFunctions)();
+
 // The most general MATMUL.  All type and shape information is taken from the
 // arguments' descriptors, and the result is dynamically allocated.
 void RTDECL(Matmul)(Descriptor &, const Descriptor &, const Descriptor &,
@@ -27,6 +68,19 @@ void RTDECL(Matmul)(Descriptor &, const Descriptor &, const Descriptor &,
 void RTDECL(MatmulDirect)(const Descriptor &, const Descriptor &,
     const Descriptor &, const char *sourceFile = nullptr, int line = 0);
 
+// MATMUL of each of a batch of small matrices: RESULT(:,:,j) =
+// MATMUL(X(:,:,j), Y(:,:,j)) for every j.  X, Y, and the result are rank-3
+// arrays of the same numeric type and kind; the batch dimension may have
+// any stride.  The operands are checked and the type is dispatched once for
+// the whole batch, and small square matrices use fixed-size kernels.
+void RTDECL(MatmulBatched)(Descriptor &, const Descriptor &,
+    const Descriptor &, const char *sourceFile = nullptr, int line = 0);
+
+// A non-allocating variant; the result's descriptor must be established
+// and have a valid base address.
+void RTDECL(MatmulBatchedDirect)(const Descriptor &, const Descriptor &,
+    const Descriptor &, const char *sourceFile = nullptr, int line = 0);
+
 // MATMUL versions specialized by the categories of the operand types.
 // The KIND and shape information is taken from the argument's
 // descriptors.
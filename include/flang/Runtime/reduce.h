@@ -13,6 +13,13 @@
 // there are typed functions here like ReduceInteger4() for total reductions
 // to scalars and void functions like ReduceInteger4Dim() for partial
 // reductions to smaller arrays.
+//
+// When ORDERED= is absent or true, the operation is applied in array element
+// order.  When `ordered` is false, the operation may be assumed to be
+// associative, and a large total reduction may be split into chunks that
+// are reduced on the runtime's worker threads (FORT_NUM_THREADS); their
+// partial results are then combined with the operation, still in array
+// element order, so that it need not be commutative.
 
 #ifndef FORTRAN_RUNTIME_REDUCE_H_
 #define FORTRAN_RUNTIME_REDUCE_H_
@@ -24,6 +24,19 @@ namespace Fortran::runtime {
 
 class Descriptor;
 
+// How SUM, DOT_PRODUCT, and NORM2 add up REAL and COMPLEX terms.
+//  Default: each intrinsic's usual method (Kahan for SUM; left to right, or
+//           as permitted by FORT_REORDER_SUMS, for DOT_PRODUCT; the scaled
+//           one-pass method for NORM2)
+//  Naive: left to right, in the order of the elements; but SUM and NORM2
+//         of 2**20 or more elements add up fixed chunks of 2**16 that
+//         way, and then combine the chunk sums in a fixed order
+//  Kahan: compensated summation, accurate but slowest
+//  Pairwise: blocks of terms summed with several vector lanes, and the block
+//            sums combined pairwise; fast, and the error grows as O(log n)
+// The initial method comes from FORT_SUMMATION in the environment.
+enum class Summation { Default, Naive, Kahan, Pairwise };
+
 extern "C" {
 
 // Reductions that are known to return scalars have per-type entry
@@ -46,6 +59,10 @@ extern "C" {
 
 // SUM()
 
+// Selects the summation method for subsequent reductions and returns the
+// method that was in effect.
+Summation RTDECL(SetSummation)(Summation);
+
 std::int8_t RTDECL(SumInteger1)(const Descriptor &, const char *source,
     int line, int dim = 0, const Descriptor *mask = nullptr);
 std::int16_t RTDECL(SumInteger2)(const Descriptor &, const char *source,
@@ -376,6 +393,22 @@ void RTDECL(Norm2DimReal16)(
 void RTDECL(Norm2Dim)(
     Descriptor &, const Descriptor &, int dim, const char *source, int line);
 
+// MINVAL, MAXVAL, SUM, and NORM2 of the same REAL array together, in a
+// single pass over its elements (an extension).  Each result whose pointer
+// is not null receives the value that the intrinsic function would return
+// with the same MASK=, which here applies to NORM2 as well.
+void RTDECL(MinMaxSumNorm2Real4)(float *minval, float *maxval, float *sum,
+    float *norm2, const Descriptor &, const char *source, int line,
+    const Descriptor *mask = nullptr);
+void RTDECL(MinMaxSumNorm2Real8)(double *minval, double *maxval, double *sum,
+    double *norm2, const Descriptor &, const char *source, int line,
+    const Descriptor *mask = nullptr);
+#if LDBL_MANT_DIG == 64
+void RTDECL(MinMaxSumNorm2Real10)(long double *minval, long double *maxval,
+    long double *sum, long double *norm2, const Descriptor &,
+    const char *source, int line, const Descriptor *mask = nullptr);
+#endif
+
 // ALL, ANY, COUNT, & PARITY logical reductions
 bool RTDECL(All)(const Descriptor &, const char *source, int line, int dim = 0);
 void RTDECL(AllDim)(Descriptor &result, const Descriptor &, int dim,
@@ -393,6 +426,10 @@ void RTDECL(ParityDim)(Descriptor &result, const Descriptor &, int dim,
     const char *source, int line);
 
 // DOT_PRODUCT
+// With FORT_REORDER_SUMS=1 in the environment, contiguous REAL and COMPLEX
+// operands of the same kind are summed with multiple partial sums.  A
+// Summation method other than Default applies to all contiguous REAL and
+// COMPLEX operands and takes precedence over FORT_REORDER_SUMS and BLAS.
 std::int8_t RTDECL(DotProductInteger1)(const Descriptor &, const Descriptor &,
     const char *source = nullptr, int line = 0);
 std::int16_t RTDECL(DotProductInteger2)(const Descriptor &, const Descriptor &,
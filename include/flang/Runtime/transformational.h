@@ -33,6 +33,23 @@ void RTDECL(Reshape)(Descriptor &result, const Descriptor &source,
     const Descriptor *order = nullptr, const char *sourceFile = nullptr,
     int line = 0);
 
+// Like Reshape(), but when SOURCE= is contiguous, ORDER= is absent or
+// [1, 2, ...], and PAD= is not needed, so that the result has the same
+// storage sequence as SOURCE=, `result` is established as a pointer
+// (CFI_attribute_pointer) to the elements of SOURCE= and true is returned.
+// Otherwise `result` is allocated as by Reshape() and false is returned.
+// Only an allocated result is to be deallocated by the caller.
+bool RTDECL(ReshapeView)(Descriptor &result, const Descriptor &source,
+    const Descriptor &shape, const Descriptor *pad = nullptr,
+    const Descriptor *order = nullptr, const char *sourceFile = nullptr,
+    int line = 0);
+
+// Replaces a view returned by ReshapeView() with a newly allocated copy of
+// its elements, for a caller that needs to modify the result, or to keep it
+// beyond the lifetime of SOURCE=; does nothing to an allocated result.
+void RTDECL(CopyReshapeView)(
+    Descriptor &result, const char *sourceFile = nullptr, int line = 0);
+
 void RTDECL(BesselJn_2)(Descriptor &result, int32_t n1, int32_t n2, float x,
     float bn2, float bn2_1, const char *sourceFile = nullptr, int line = 0);
 
@@ -8,6 +8,7 @@
 
 #include "flang/Runtime/assign.h"
 #include "assign-impl.h"
+#include "copy.h"
 #include "derived.h"
 #include "stat.h"
 #include "terminator.h"
@@ -140,6 +141,16 @@ static RT_API_ATTRS void MaximalByteOffsetRange(
   most += desc.ElementBytes() - 1;
 }
 
+static RT_API_ATTRS std::uint64_t GreatestCommonDivisor(
+    std::uint64_t a, std::uint64_t b) {
+  while (b != 0) {
+    std::uint64_t r{a % b};
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
 static inline RT_API_ATTRS bool RangesOverlap(const char *aStart,
     const char *aEnd, const char *bStart, const char *bEnd) {
   return aEnd >= bStart && bEnd >= aStart;
@@ -172,10 +183,134 @@ static RT_API_ATTRS bool MayAlias(const Descriptor &x, const Descriptor &y) {
           xBase + xLeast, xBase + xMost, yBase + yLeast, yBase + yMost)) {
     return false; // no storage overlap
   }
-  // TODO: check dimensions: if any is independent, return false
+  // Every element of x begins at xBase plus a multiple of the greatest
+  // common divisor of all of the byte strides, and likewise for y; so the
+  // difference of any two element addresses is congruent to yBase - xBase.
+  // This separates interleaved sections like A(1:N:2) and A(2:N:2), or
+  // A(1,:) and A(2,:).
+  std::uint64_t divisor{0};
+  for (const Descriptor *desc : {&x, &y}) {
+    for (int j{0}; j < desc->rank(); ++j) {
+      const auto &dim{desc->GetDimension(j)};
+      if (dim.Extent() > 1) {
+        auto sm{dim.ByteStride()};
+        divisor = GreatestCommonDivisor(
+            divisor, static_cast<std::uint64_t>(sm < 0 ? -sm : sm));
+      }
+    }
+  }
+  if (divisor > 0) {
+    auto modulus{static_cast<std::int64_t>(divisor)};
+    std::int64_t difference{(yBase - xBase) % modulus};
+    if (difference < 0) {
+      difference += modulus;
+    }
+    auto xBytes{static_cast<std::int64_t>(x.ElementBytes())};
+    auto yBytes{static_cast<std::int64_t>(y.ElementBytes())};
+    if (difference >= xBytes && difference + yBytes <= modulus) {
+      return false; // y elements all fall between x elements
+    }
+  }
   return true;
 }
 
+// When the left- and right-hand sides of an assignment have the same
+// shape, element size, and byte strides, and their element addresses
+// strictly increase (or decrease) in array element order, each RHS element
+// lies at the same displacement from the LHS element to which it is
+// assigned.  Copying the elements in the order that moves away from that
+// displacement never overwrites an RHS element before it has been read,
+// so no temporary is needed.  Returns 1 for ascending element order, -1 for
+// descending, and 0 when neither is known to be safe.
+static RT_API_ATTRS int SafeCopyDirection(
+    const Descriptor &to, const Descriptor &from) {
+  int rank{to.rank()};
+  auto bytes{static_cast<std::int64_t>(to.ElementBytes())};
+  if (rank == 0 || from.rank() != rank ||
+      static_cast<std::int64_t>(from.ElementBytes()) != bytes ||
+      bytes == 0) {
+    return 0;
+  }
+  int sign{0};
+  std::int64_t span{0}; // of the dimensions so far, less one element
+  for (int j{0}; j < rank; ++j) {
+    const auto &toDim{to.GetDimension(j)};
+    const auto &fromDim{from.GetDimension(j)};
+    auto extent{toDim.Extent()};
+    auto sm{toDim.ByteStride()};
+    if (fromDim.Extent() != extent || fromDim.ByteStride() != sm) {
+      return 0;
+    }
+    if (extent > 1) {
+      int smSign{sm < 0 ? -1 : 1};
+      if ((sign != 0 && smSign != sign) || sm * smSign < span + bytes) {
+        return 0; // elements are interleaved or reordered
+      }
+      sign = smSign;
+      span += (extent - 1) * sm * smSign;
+    }
+  }
+  auto displacement{
+      from.OffsetElement<const char>() - to.OffsetElement<const char>()};
+  return displacement * sign >= 0 ? 1 : -1;
+}
+
+// Copies the elements of "from" to "to", which have been found by
+// SafeCopyDirection() to be safe to copy in place in element order
+// (direction 1) or its reverse (direction -1).
+static RT_API_ATTRS void CopyInDirection(
+    const Descriptor &to, const Descriptor &from, int direction) {
+  char *toBase{to.OffsetElement<char>()};
+  const char *fromBase{from.OffsetElement<const char>()};
+  if (toBase == fromBase) {
+    return; // same elements
+  }
+  int rank{to.rank()};
+  std::size_t bytes{to.ElementBytes()};
+  SubscriptValue extent[maxRank], sm[maxRank], at[maxRank];
+  std::size_t rows{1};
+  for (int j{0}; j < rank; ++j) {
+    extent[j] = to.GetDimension(j).Extent();
+    sm[j] = to.GetDimension(j).ByteStride();
+    at[j] = direction > 0 ? 0 : extent[j] - 1;
+    if (j > 0) {
+      rows *= extent[j];
+    }
+  }
+  SubscriptValue n{extent[0]};
+  if (n <= 0 || rows == 0) {
+    return;
+  }
+  for (; rows-- > 0;) {
+    std::int64_t offset{0};
+    for (int j{1}; j < rank; ++j) {
+      offset += at[j] * sm[j];
+    }
+    if (sm[0] == static_cast<SubscriptValue>(bytes)) { // contiguous row
+      Fortran::runtime::memmove(toBase + offset, fromBase + offset, n * bytes);
+    } else {
+      for (SubscriptValue k{0}; k < n; ++k) {
+        auto elementOffset{offset + (direction > 0 ? k : n - 1 - k) * sm[0]};
+        Fortran::runtime::memmove(
+            toBase + elementOffset, fromBase + elementOffset, bytes);
+      }
+    }
+    for (int j{1}; j < rank; ++j) {
+      if (direction > 0) {
+        if (++at[j] < extent[j]) {
+          break;
+        }
+        at[j] = 0;
+      } else {
+        if (at[j]-- > 0) {
+          break;
+        }
+        at[j] = extent[j] - 1;
+      }
+    }
+  }
+}
+
 static RT_API_ATTRS void DoScalarDefinedAssignment(const Descriptor &to,
     const Descriptor &from, const typeInfo::SpecialBinding &special) {
   bool toIsDesc{special.IsArgDescriptor(0)};
@@ -271,12 +406,16 @@ RT_API_ATTRS static void Assign(
   };
   StaticDescriptor<maxRank, true, 10 /*?*/> deferredDeallocStatDesc;
   Descriptor *deferDeallocation{nullptr};
+  int copyDirection{0}; // nonzero when overlapping data can be copied in place
   if (MayAlias(to, from)) {
+    if (!mustDeallocateLHS && !toDerived && !isSimpleMemmove()) {
+      copyDirection = SafeCopyDirection(to, from);
+    }
     if (mustDeallocateLHS) {
       deferDeallocation = &deferredDeallocStatDesc.descriptor();
       std::memcpy(deferDeallocation, &to, to.SizeInBytes());
       to.set_base_addr(nullptr);
-    } else if (!isSimpleMemmove()) {
+    } else if (!isSimpleMemmove() && copyDirection == 0) {
       // Handle LHS/RHS aliasing by copying RHS into a temp, then
       // recursively assigning from that temp.
       auto descBytes{from.SizeInBytes()};
@@ -504,12 +643,11 @@ RT_API_ATTRS static void Assign(
         terminator.Crash("unexpected type code %d in blank padded Assign()",
             to.type().raw());
       }
+    } else if (copyDirection != 0) { // overlapping, same shape and strides
+      CopyInDirection(to, from, copyDirection);
     } else { // elemental copies, possibly with character truncation
-      for (std::size_t n{toElements}; n-- > 0;
-           to.IncrementSubscripts(toAt), from.IncrementSubscripts(fromAt)) {
-        Fortran::runtime::memmove(to.Element<char>(toAt),
-            from.Element<const char>(fromAt), toElementBytes);
-      }
+      // Any other overlap was dealt with above by copying the RHS.
+      CopyElementRuns(to, from, toElementBytes);
     }
   }
   if (deferDeallocation) {
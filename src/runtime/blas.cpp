@@ -0,0 +1,105 @@
+//===-- runtime/blas.cpp --------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Registration of external BLAS routines, and the reference implementations
+// returned by ReferenceBlasFunctions().
+
+#include "blas.h"
+#include "flang/Runtime/matmul.h"
+
+namespace Fortran::runtime {
+
+static BlasFunctions registeredBlas;
+static bool haveRegisteredBlas{false};
+
+const BlasFunctions *GetBlasFunctions() {
+  return haveRegisteredBlas ? &registeredBlas : nullptr;
+}
+
+// Straightforward versions of the routines that follow the reference BLAS
+// semantics, including transposition, scaling, leading dimensions and
+// negative increments, without any attempt at speed.
+
+static bool IsTransposed(const char *trans) {
+  return *trans == 'T' || *trans == 't' || *trans == 'C' || *trans == 'c';
+}
+
+template <typename T>
+static void ReferenceGemm(const char *transa, const char *transb,
+    const int *m, const int *n, const int *k, const T *alpha, const T *a,
+    const int *lda, const T *b, const int *ldb, const T *beta, T *c,
+    const int *ldc) {
+  bool ta{IsTransposed(transa)}, tb{IsTransposed(transb)};
+  for (int j{0}; j < *n; ++j) {
+    for (int i{0}; i < *m; ++i) {
+      T sum{0};
+      for (int l{0}; l < *k; ++l) {
+        T aElement{ta ? a[l + i * *lda] : a[i + l * *lda]};
+        T bElement{tb ? b[j + l * *ldb] : b[l + j * *ldb]};
+        sum += aElement * bElement;
+      }
+      T &cElement{c[i + j * *ldc]};
+      cElement = *alpha * sum + (*beta == 0 ? T{0} : *beta * cElement);
+    }
+  }
+}
+
+template <typename T>
+static void ReferenceGemv(const char *trans, const int *m, const int *n,
+    const T *alpha, const T *a, const int *lda, const T *x, const int *incx,
+    const T *beta, T *y, const int *incy) {
+  bool ta{IsTransposed(trans)};
+  int ylen{ta ? *n : *m}, xlen{ta ? *m : *n};
+  int ix0{*incx < 0 ? (1 - xlen) * *incx : 0};
+  int iy{*incy < 0 ? (1 - ylen) * *incy : 0};
+  for (int i{0}; i < ylen; ++i, iy += *incy) {
+    T sum{0};
+    for (int l{0}, ix{ix0}; l < xlen; ++l, ix += *incx) {
+      sum += (ta ? a[l + i * *lda] : a[i + l * *lda]) * x[ix];
+    }
+    y[iy] = *alpha * sum + (*beta == 0 ? T{0} : *beta * y[iy]);
+  }
+}
+
+template <typename T>
+static T ReferenceDot(
+    const int *n, const T *x, const int *incx, const T *y, const int *incy) {
+  T sum{0};
+  int ix{*incx < 0 ? (1 - *n) * *incx : 0};
+  int iy{*incy < 0 ? (1 - *n) * *incy : 0};
+  for (int j{0}; j < *n; ++j, ix += *incx, iy += *incy) {
+    sum += x[ix] * y[iy];
+  }
+  return sum;
+}
+
+static const BlasFunctions referenceBlas{
+    ReferenceGemm<float>,
+    ReferenceGemm<double>,
+    ReferenceGemv<float>,
+    ReferenceGemv<double>,
+    ReferenceDot<float>,
+    ReferenceDot<double>,
+    0,
+};
+
+extern "C" {
+
+void RTDEF(RegisterBlasFunctions)(const BlasFunctions *blas) {
+  if (blas) {
+    registeredBlas = *blas;
+    haveRegisteredBlas = true;
+  } else {
+    haveRegisteredBlas = false;
+  }
+}
+
+const BlasFunctions *RTDEF(ReferenceBlasFunctions)() { return &referenceBlas; }
+
+} // extern "C"
+} // namespace Fortran::runtime
@@ -0,0 +1,143 @@
+//===-- runtime/blas.h ------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Dispatch to the BLAS routines registered with RegisterBlasFunctions().
+// Each of these returns false (or nothing) when no routine is registered for
+// the type, when the operation is too small to be worth the call, or when
+// the operands cannot be described with BLAS leading dimensions and
+// increments; the caller then falls back to its own loops.
+
+#ifndef FORTRAN_RUNTIME_BLAS_H_
+#define FORTRAN_RUNTIME_BLAS_H_
+
+#include "flang/Common/optional.h"
+#include "flang/Runtime/descriptor.h"
+#include "flang/Runtime/matmul.h"
+#include <algorithm>
+#include <climits>
+#include <type_traits>
+
+namespace Fortran::runtime {
+
+// The registered routines, or null.
+const BlasFunctions *GetBlasFunctions();
+
+template <typename T>
+constexpr bool IsBlasType{
+    std::is_same_v<T, float> || std::is_same_v<T, double>};
+
+inline RT_API_ATTRS bool FitsBlasInt(SubscriptValue n) {
+  return n >= 0 && n <= INT_MAX;
+}
+
+// RES(rows,cols) = op(X) * Y, where X is rows x n (transposeX false) or
+// n x rows (transposeX true) with leading dimension ldx, and Y is n x cols
+// with leading dimension ldy.  RES is contiguous.
+template <typename T>
+inline RT_API_ATTRS bool BlasMatrixTimesMatrix(T *product,
+    SubscriptValue rows, SubscriptValue cols, const T *x, SubscriptValue ldx,
+    bool transposeX, const T *y, SubscriptValue ldy, SubscriptValue n) {
+#if !defined(RT_DEVICE_COMPILATION)
+  if constexpr (IsBlasType<T>) {
+    const BlasFunctions *blas{GetBlasFunctions()};
+    if (!blas ||
+        static_cast<std::size_t>(rows) * cols * n < blas->minimumWork) {
+      return false;
+    }
+    auto *gemm{[&]() {
+      if constexpr (std::is_same_v<T, float>) {
+        return blas->sgemm;
+      } else {
+        return blas->dgemm;
+      }
+    }()};
+    if (!gemm || !FitsBlasInt(rows) || !FitsBlasInt(cols) || !FitsBlasInt(n) ||
+        !FitsBlasInt(ldx) || ldx < std::max<SubscriptValue>(
+                                       1, transposeX ? n : rows) ||
+        !FitsBlasInt(ldy) || ldy < std::max<SubscriptValue>(1, n)) {
+      return false;
+    }
+    int m{static_cast<int>(rows)}, nc{static_cast<int>(cols)};
+    int k{static_cast<int>(n)}, lda{static_cast<int>(ldx)};
+    int ldb{static_cast<int>(ldy)}, ldc{std::max(m, 1)};
+    T alpha{1}, beta{0};
+    gemm(transposeX ? "T" : "N", "N", &m, &nc, &k, &alpha, x, &lda, y, &ldb,
+        &beta, product, &ldc);
+    return true;
+  }
+#endif
+  return false;
+}
+
+// RES(rows) = op(A) * V for a rows x n matrix op(A), where A is stored with
+// leading dimension lda as rows x n (transposeA false) or as n x rows
+// (transposeA true).  V and RES are contiguous.
+template <typename T>
+inline RT_API_ATTRS bool BlasMatrixTimesVector(T *product,
+    SubscriptValue rows, SubscriptValue n, const T *a, SubscriptValue lda,
+    bool transposeA, const T *v) {
+#if !defined(RT_DEVICE_COMPILATION)
+  if constexpr (IsBlasType<T>) {
+    const BlasFunctions *blas{GetBlasFunctions()};
+    if (!blas || static_cast<std::size_t>(rows) * n < blas->minimumWork) {
+      return false;
+    }
+    auto *gemv{[&]() {
+      if constexpr (std::is_same_v<T, float>) {
+        return blas->sgemv;
+      } else {
+        return blas->dgemv;
+      }
+    }()};
+    // GEMV's M and N are the dimensions of A as stored.
+    SubscriptValue storedRows{transposeA ? n : rows};
+    SubscriptValue storedCols{transposeA ? rows : n};
+    if (!gemv || !FitsBlasInt(storedRows) || !FitsBlasInt(storedCols) ||
+        !FitsBlasInt(lda) || lda < std::max<SubscriptValue>(1, storedRows)) {
+      return false;
+    }
+    int m{static_cast<int>(storedRows)}, nc{static_cast<int>(storedCols)};
+    int ld{static_cast<int>(lda)}, one{1};
+    T alpha{1}, beta{0};
+    gemv(transposeA ? "T" : "N", &m, &nc, &alpha, a, &ld, v, &one, &beta,
+        product, &one);
+    return true;
+  }
+#endif
+  return false;
+}
+
+// DOT_PRODUCT of two contiguous vectors.
+template <typename T>
+inline RT_API_ATTRS Fortran::common::optional<T> BlasDotProduct(
+    SubscriptValue n, const T *x, const T *y) {
+#if !defined(RT_DEVICE_COMPILATION)
+  if constexpr (IsBlasType<T>) {
+    const BlasFunctions *blas{GetBlasFunctions()};
+    if (!blas || static_cast<std::size_t>(n) < blas->minimumWork ||
+        !FitsBlasInt(n)) {
+      return Fortran::common::nullopt;
+    }
+    auto *dot{[&]() {
+      if constexpr (std::is_same_v<T, float>) {
+        return blas->sdot;
+      } else {
+        return blas->ddot;
+      }
+    }()};
+    if (dot) {
+      int count{static_cast<int>(n)}, one{1};
+      return dot(&count, x, &one, y, &one);
+    }
+  }
+#endif
+  return Fortran::common::nullopt;
+}
+
+} // namespace Fortran::runtime
+#endif // FORTRAN_RUNTIME_BLAS_H_
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "copy.h"
+#include "derived.h"
 #include "terminator.h"
 #include "type-info.h"
 #include "flang/Runtime/allocatable.h"
@@ -16,6 +17,23 @@
 namespace Fortran::runtime {
 RT_OFFLOAD_API_GROUP_BEGIN
 
+// Duplicates the allocatable components of an element that has just been
+// copied from another, following their type's plan.
+static RT_API_ATTRS void CopyAllocatables(char *toPtr, const char *fromPtr,
+    const ComponentPlan &plan, Terminator &terminator) {
+  for (std::size_t k{0}; k < plan.allocatables; ++k) {
+    std::size_t offset{plan.step[k].offset};
+    Descriptor &toDesc{*reinterpret_cast<Descriptor *>(toPtr + offset)};
+    if (toDesc.raw().base_addr != nullptr) {
+      toDesc.set_base_addr(nullptr);
+      RUNTIME_CHECK(terminator, toDesc.Allocate() == CFI_SUCCESS);
+      const Descriptor &fromDesc{
+          *reinterpret_cast<const Descriptor *>(fromPtr + offset)};
+      CopyArray(toDesc, fromDesc, terminator);
+    }
+  }
+}
+
 RT_API_ATTRS void CopyElement(const Descriptor &to, const SubscriptValue toAt[],
     const Descriptor &from, const SubscriptValue fromAt[],
     Terminator &terminator) {
@@ -29,6 +47,10 @@ RT_API_ATTRS void CopyElement(const Descriptor &to, const SubscriptValue toAt[],
         derived && !derived->noDestructionNeeded()) {
       RUNTIME_CHECK(terminator,
           from.Addendum() && derived == from.Addendum()->derivedType());
+      if (const ComponentPlan * plan{GetComponentPlan(*derived)}) {
+        CopyAllocatables(toPtr, fromPtr, *plan, terminator);
+        return;
+      }
       const Descriptor &componentDesc{derived->component()};
       const typeInfo::Component *component{
           componentDesc.OffsetElement<typeInfo::Component>()};
@@ -71,13 +93,126 @@ RT_API_ATTRS void CopyElement(const Descriptor &to, const SubscriptValue toAt[],
   }
 }
 
+RT_API_ATTRS void CopyStrided(char *to, SubscriptValue toStride,
+    const char *from, SubscriptValue fromStride, SubscriptValue count,
+    std::size_t bytes) {
+  DispatchOnElementBytes(bytes, [&](auto elementBytes) {
+    CopyStrided<elementBytes>(to, toStride, from, fromStride, count, bytes);
+  });
+}
+
+// Walks the elements of an array in array element order as a sequence of
+// runs, along each of which the address advances by a constant byte
+// stride.  The leading dimensions are folded into a run for as long as
+// each one continues the stride of those before it, so a contiguous array
+// is a single run.  A scalar is a run of unbounded length (0) and zero
+// stride, so that it is replicated.
+class StridedRuns {
+public:
+  explicit RT_API_ATTRS StridedRuns(const Descriptor &array) : array_{array} {
+    array.GetLowerBounds(at_);
+    if (int rank{array.rank()}; rank > 0) {
+      const Dimension &dim0{array.GetDimension(0)};
+      stride_ = dim0.ByteStride();
+      length_ = dim0.Extent();
+      for (folded_ = 1; folded_ < rank; ++folded_) {
+        const Dimension &dim{array.GetDimension(folded_)};
+        SubscriptValue extent{dim.Extent()};
+        if (length_ == 1) {
+          stride_ = dim.ByteStride();
+        } else if (extent != 1 &&
+            dim.ByteStride() !=
+                stride_ * static_cast<SubscriptValue>(length_)) {
+          break;
+        }
+        length_ *= extent;
+      }
+    }
+  }
+
+  RT_API_ATTRS std::size_t length() const { return length_; }
+  RT_API_ATTRS SubscriptValue stride() const { return stride_; }
+  RT_API_ATTRS char *address() const {
+    return array_.Element<char>(at_) +
+        static_cast<SubscriptValue>(offset_) * stride_;
+  }
+
+  // Moves past the next `n` elements, which must not extend past the end
+  // of the current run.
+  RT_API_ATTRS void Advance(std::size_t n) {
+    offset_ += n;
+    if (offset_ == length_) {
+      offset_ = 0;
+      for (int j{0}; j < folded_; ++j) {
+        at_[j] = array_.GetDimension(j).UpperBound();
+      }
+      array_.IncrementSubscripts(at_);
+    }
+  }
+
+private:
+  const Descriptor &array_;
+  SubscriptValue at_[maxRank];
+  int folded_{0}; // leading dimensions that make up a run
+  std::size_t length_{0}; // elements in each run
+  SubscriptValue stride_{0};
+  std::size_t offset_{0}; // elements of the current run already passed
+};
+
+RT_API_ATTRS void CopyElementRuns(
+    const Descriptor &to, const Descriptor &from, std::size_t bytes) {
+  // Copy the longest stretches that lie within a run of both arrays at
+  // once.  Runs begin at multiples of their lengths, so their greatest
+  // common divisor is the length to copy.
+  StridedRuns toRuns{to}, fromRuns{from};
+  std::size_t length{toRuns.length()};
+  for (std::size_t other{fromRuns.length()}; other > 0;) {
+    std::size_t remainder{length % other};
+    length = other;
+    other = remainder;
+  }
+  if (length == 0) { // both are scalars
+    length = 1;
+  }
+  DispatchOnElementBytes(bytes, [&](auto elementBytes) {
+    for (std::size_t elements{to.Elements()}; elements > 0;
+         elements -= length) {
+      CopyStrided<elementBytes>(toRuns.address(), toRuns.stride(),
+          fromRuns.address(), fromRuns.stride(), length, bytes);
+      toRuns.Advance(length);
+      fromRuns.Advance(length);
+    }
+  });
+}
+
 RT_API_ATTRS void CopyArray(
     const Descriptor &to, const Descriptor &from, Terminator &terminator) {
   std::size_t elements{to.Elements()};
   RUNTIME_CHECK(terminator, elements == from.Elements());
+  if (!HasDynamicComponent(to)) {
+    RUNTIME_CHECK(terminator, to.ElementBytes() == from.ElementBytes());
+    CopyElementRuns(to, from, to.ElementBytes());
+    return;
+  }
   SubscriptValue toAt[maxRank], fromAt[maxRank];
   to.GetLowerBounds(toAt);
   from.GetLowerBounds(fromAt);
+  const typeInfo::DerivedType &derived{*to.Addendum()->derivedType()};
+  if (const ComponentPlan * plan{GetComponentPlan(derived)}) {
+    // Look the plan up once for the whole array.
+    std::size_t bytes{to.ElementBytes()};
+    RUNTIME_CHECK(terminator,
+        bytes == from.ElementBytes() && from.Addendum() &&
+            &derived == from.Addendum()->derivedType());
+    for (; elements-- > 0;
+         to.IncrementSubscripts(toAt), from.IncrementSubscripts(fromAt)) {
+      char *toPtr{to.Element<char>(toAt)};
+      const char *fromPtr{from.Element<char>(fromAt)};
+      std::memcpy(toPtr, fromPtr, bytes);
+      CopyAllocatables(toPtr, fromPtr, *plan, terminator);
+    }
+    return;
+  }
   while (elements-- > 0) {
     CopyElement(to, toAt, from, fromAt, terminator);
     to.IncrementSubscripts(toAt);
@@ -13,6 +13,8 @@
 #define FORTRAN_RUNTIME_COPY_H_
 
 #include "flang/Runtime/descriptor.h"
+#include <cstring>
+#include <type_traits>
 
 namespace Fortran::runtime {
 
@@ -22,8 +24,66 @@ RT_API_ATTRS void CopyElement(const Descriptor &to, const SubscriptValue toAt[],
     const Descriptor &from, const SubscriptValue fromAt[], Terminator &);
 
 // Copies data from one allocated descriptor's array to another.
+// Elements without allocatable or automatic components are copied with
+// CopyElementRuns().
 RT_API_ATTRS void CopyArray(
     const Descriptor &to, const Descriptor &from, Terminator &);
 
+// Copies the first `bytes` bytes of each element of `from` to the element
+// of `to` in the same position in array element order, without duplicating
+// any components.  The arrays must have the same number of elements, or
+// `from` is a scalar that is replicated, and must not overlap.  Stretches
+// of elements that are evenly spaced in both arrays, across as many leading
+// dimensions as their strides allow, are copied at once by CopyStrided().
+RT_API_ATTRS void CopyElementRuns(
+    const Descriptor &to, const Descriptor &from, std::size_t bytes);
+
+// Calls `f` with a std::integral_constant<std::size_t, BYTES> for copies of
+// elements of `bytes` bytes apiece, and returns what it returns.  BYTES is
+// the element size when it is one of the common ones, so that each copy
+// becomes a single move, and otherwise 0, when `bytes` is used.
+template <typename F>
+inline RT_API_ATTRS decltype(auto) DispatchOnElementBytes(
+    std::size_t bytes, const F &f) {
+  switch (bytes) {
+  case 1:
+    return f(std::integral_constant<std::size_t, 1>{});
+  case 2:
+    return f(std::integral_constant<std::size_t, 2>{});
+  case 4:
+    return f(std::integral_constant<std::size_t, 4>{});
+  case 8:
+    return f(std::integral_constant<std::size_t, 8>{});
+  case 16:
+    return f(std::integral_constant<std::size_t, 16>{});
+  default:
+    return f(std::integral_constant<std::size_t, 0>{});
+  }
+}
+
+// Copies `count` elements (or blocks) of `bytes` bytes apiece from `from`
+// to `to`, whose consecutive elements are `fromStride` and `toStride` bytes
+// apart; a `fromStride` of zero replicates one element.  No components are
+// duplicated.  BYTES is as for DispatchOnElementBytes().
+template <std::size_t BYTES>
+inline RT_API_ATTRS void CopyStrided(char *to, SubscriptValue toStride,
+    const char *from, SubscriptValue fromStride, SubscriptValue count,
+    std::size_t bytes) {
+  const auto elementBytes{
+      static_cast<SubscriptValue>(BYTES > 0 ? BYTES : bytes)};
+  if (toStride == elementBytes && fromStride == elementBytes) {
+    std::memcpy(to, from, count * elementBytes);
+  } else {
+    for (; count-- > 0; to += toStride, from += fromStride) {
+      std::memcpy(to, from, elementBytes);
+    }
+  }
+}
+
+// CopyStrided<BYTES>() for the BYTES that suits `bytes`.
+RT_API_ATTRS void CopyStrided(char *to, SubscriptValue toStride,
+    const char *from, SubscriptValue fromStride, SubscriptValue count,
+    std::size_t bytes);
+
 } // namespace Fortran::runtime
 #endif // FORTRAN_RUNTIME_COPY_H_
@@ -12,6 +12,8 @@
 #include "tools.h"
 #include "type-info.h"
 #include "flang/Runtime/descriptor.h"
+#include <algorithm>
+#include <atomic>
 
 namespace Fortran::runtime {
 
@@ -29,9 +31,248 @@ static RT_API_ATTRS void GetComponentExtents(SubscriptValue (&extents)[maxRank],
   }
 }
 
+// Longer plans, which come from large arrays of nested derived type
+// components, are not worth building.
+static constexpr std::size_t maxPlanSteps{256};
+
+static RT_API_ATTRS bool AddPlanSteps(
+    ComponentPlan::Step (&)[maxPlanSteps], std::size_t &,
+    const typeInfo::DerivedType &, const Descriptor &, std::size_t);
+
+// Appends the steps for each element of the nested derived type component
+// `comp` at `offset`.
+static RT_API_ATTRS bool AddNestedPlanSteps(
+    ComponentPlan::Step (&steps)[maxPlanSteps], std::size_t &count,
+    const typeInfo::Component &comp, const Descriptor &instance,
+    std::size_t offset) {
+  const typeInfo::DerivedType &compType{*comp.derivedType()};
+  StaticDescriptor<0, true> staticDescriptor;
+  Descriptor &element{staticDescriptor.descriptor()};
+  element.Establish(compType, nullptr, 0);
+  std::size_t elements{1};
+  const typeInfo::Value *bounds{comp.bounds()};
+  for (int j{0}; j < comp.rank(); ++j) {
+    auto lb{bounds[2 * j].GetValue(&instance)};
+    auto ub{bounds[2 * j + 1].GetValue(&instance)};
+    if (!lb || !ub) {
+      return false;
+    }
+    elements *= *ub >= *lb ? static_cast<std::size_t>(*ub - *lb + 1) : 0;
+  }
+  for (std::size_t j{0}; j < elements; ++j) {
+    if (!AddPlanSteps(steps, count, compType, element,
+            offset + j * compType.sizeInBytes())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Appends the steps for an element of `derived` at `offset` to those in
+// steps[0..count); returns false when the type can't have a plan.
+// `instance` is a scalar descriptor for an element of `derived`; its
+// base address is not used.
+static RT_API_ATTRS bool AddPlanSteps(
+    ComponentPlan::Step (&steps)[maxPlanSteps], std::size_t &count,
+    const typeInfo::DerivedType &derived, const Descriptor &instance,
+    std::size_t offset) {
+  if (derived.LenParameters() > 0) {
+    return false;
+  }
+  const Descriptor &componentDesc{derived.component()};
+  std::size_t components{componentDesc.Elements()};
+  for (std::size_t k{0}; k < components; ++k) {
+    const auto &comp{
+        *componentDesc.ZeroBasedIndexedElement<typeInfo::Component>(k)};
+    std::size_t at{offset + comp.offset()};
+    const typeInfo::DerivedType *compType{comp.derivedType()};
+    ComponentPlan::Action action;
+    if (comp.genre() == typeInfo::Component::Genre::Automatic) {
+      return false;
+    } else if (comp.genre() == typeInfo::Component::Genre::Allocatable) {
+      action = ComponentPlan::Action::Allocatable;
+    } else if (comp.initialization()) {
+      action = ComponentPlan::Action::Initialize;
+    } else if (comp.genre() == typeInfo::Component::Genre::Pointer) {
+      action = ComponentPlan::Action::Pointer;
+    } else if (compType &&
+        (!compType->noInitializationNeeded() ||
+            !compType->noDestructionNeeded())) {
+      if (!AddNestedPlanSteps(steps, count, comp, instance, at)) {
+        return false;
+      }
+      continue;
+    } else {
+      continue;
+    }
+    if (count == maxPlanSteps) {
+      return false;
+    }
+    // Without LEN parameters, sizes depend only on the type of `instance`.
+    steps[count++] = ComponentPlan::Step{action, at, &comp,
+        comp.initialization(), comp.SizeInBytes(instance), nullptr};
+    if (action == ComponentPlan::Action::Initialize &&
+        comp.genre() == typeInfo::Component::Genre::Data && compType &&
+        !compType->noDestructionNeeded()) {
+      // The initializer supplies the descriptors of the nested allocatable
+      // components, but they still have to be duplicated and deallocated.
+      std::size_t first{count};
+      if (!AddNestedPlanSteps(steps, count, comp, instance, at)) {
+        return false;
+      }
+      count = std::remove_if(steps + first, steps + count,
+                  [](const ComponentPlan::Step &step) {
+                    return step.action != ComponentPlan::Action::Allocatable;
+                  }) -
+          steps;
+    }
+  }
+  const Descriptor &procPtrDesc{derived.procPtr()};
+  std::size_t procPtrs{procPtrDesc.Elements()};
+  for (std::size_t k{0}; k < procPtrs; ++k) {
+    const auto &comp{
+        *procPtrDesc.ZeroBasedIndexedElement<typeInfo::ProcPtrComponent>(k)};
+    if (count == maxPlanSteps) {
+      return false;
+    }
+    steps[count++] = ComponentPlan::Step{ComponentPlan::Action::ProcPtr,
+        offset + comp.offset, nullptr, nullptr, 0, comp.procInitialization};
+  }
+  return true;
+}
+
+// Default-initializes one element by the steps of a plan; no allocations
+// are needed.
+static RT_API_ATTRS void InitializeElement(char *element,
+    const ComponentPlan &plan, const Descriptor &container,
+    Terminator &terminator) {
+  for (std::size_t k{0}; k < plan.steps; ++k) {
+    const ComponentPlan::Step &step{plan.step[k]};
+    char *ptr{element + step.offset};
+    switch (step.action) {
+    case ComponentPlan::Action::Allocatable:
+    case ComponentPlan::Action::Pointer: {
+      Descriptor &desc{*reinterpret_cast<Descriptor *>(ptr)};
+      step.component->EstablishDescriptor(desc, container, terminator);
+      desc.raw().attribute = step.action == ComponentPlan::Action::Allocatable
+          ? CFI_attribute_allocatable
+          : CFI_attribute_pointer;
+    } break;
+    case ComponentPlan::Action::Initialize:
+      std::memcpy(ptr, step.initialization, step.bytes);
+      break;
+    case ComponentPlan::Action::ProcPtr:
+      *reinterpret_cast<typeInfo::ProcedurePointer *>(ptr) =
+          step.procInitialization;
+      break;
+    }
+  }
+}
+
+static RT_API_ATTRS ComponentPlan *BuildComponentPlan(
+    const typeInfo::DerivedType &derived) {
+  ComponentPlan::Step steps[maxPlanSteps];
+  std::size_t count{0};
+  StaticDescriptor<0, true> staticDescriptor;
+  Descriptor &element{staticDescriptor.descriptor()};
+  element.Establish(derived, nullptr, 0);
+  bool usable{AddPlanSteps(steps, count, derived, element, 0)};
+  std::size_t imageBytes{usable ? derived.sizeInBytes() : 0};
+  if (!usable) {
+    count = 0;
+  }
+  Terminator terminator{"BuildComponentPlan() in Fortran runtime", 0};
+  std::size_t stepBytes{count * sizeof(ComponentPlan::Step)};
+  void *storage{AllocateMemoryOrCrash(
+      terminator, sizeof(ComponentPlan) + stepBytes + imageBytes)};
+  auto *plan{static_cast<ComponentPlan *>(storage)};
+  auto *step{reinterpret_cast<ComponentPlan::Step *>(plan + 1)};
+  char *image{reinterpret_cast<char *>(step) + stepBytes};
+  *plan = ComponentPlan{&derived, nullptr, usable, count, 0, step, image};
+  // Put the Allocatable steps first.
+  for (int pass{0}; pass < 2; ++pass) {
+    for (std::size_t j{0}; j < count; ++j) {
+      if ((steps[j].action == ComponentPlan::Action::Allocatable) ==
+          (pass == 0)) {
+        *step++ = steps[j];
+        plan->allocatables += pass == 0;
+      }
+    }
+  }
+  // Without LEN parameters, the default-initialized value of an element
+  // is the same everywhere; components without default initialization
+  // are left zero.
+  std::memset(image, 0, imageBytes);
+  if (usable) {
+    element.Establish(derived, image, 0);
+    InitializeElement(image, *plan, element, terminator);
+  }
+  return plan;
+}
+
+RT_API_ATTRS const ComponentPlan *GetComponentPlan(
+    const typeInfo::DerivedType &derived) {
+#if defined(RT_DEVICE_COMPILATION)
+  return nullptr;
+#else
+  // Plans are never freed or changed once published, so lookups take no
+  // lock.  Two threads that build a type's first plan at the same time
+  // both insert it, which is harmless.
+  static constexpr std::size_t buckets{64};
+  static std::atomic<const ComponentPlan *> cache[buckets];
+  auto &bucket{
+      cache[(reinterpret_cast<std::uintptr_t>(&derived) >> 4) % buckets]};
+  const ComponentPlan *head{bucket.load(std::memory_order_acquire)};
+  for (const ComponentPlan *p{head}; p; p = p->next) {
+    if (p->derived == &derived) {
+      return p->usable ? p : nullptr;
+    }
+  }
+  ComponentPlan *plan{BuildComponentPlan(derived)};
+  do {
+    plan->next = head;
+  } while (!bucket.compare_exchange_weak(
+      head, plan, std::memory_order_release, std::memory_order_acquire));
+  return plan->usable ? plan : nullptr;
+#endif
+}
+
+// Fills an array with copies of the default-initialized element image of
+// its type's plan.  A contiguous array is filled by copying the elements
+// already in place, a cache-sized block at most at a time so that the
+// copies read from the cache.
+static RT_API_ATTRS void StampImage(
+    const Descriptor &instance, const ComponentPlan &plan) {
+  std::size_t bytes{plan.derived->sizeInBytes()};
+  std::size_t elements{instance.Elements()};
+  if (elements == 0 || bytes == 0) {
+    return;
+  }
+  if (instance.IsContiguous() && instance.ElementBytes() == bytes) {
+    char *to{instance.OffsetElement<char>()};
+    std::memcpy(to, plan.image, bytes);
+    std::size_t block{std::max<std::size_t>(1, (std::size_t{1} << 16) / bytes)};
+    for (std::size_t done{1}; done < elements;) {
+      std::size_t more{std::min(std::min(done, block), elements - done)};
+      std::memcpy(to + done * bytes, to, more * bytes);
+      done += more;
+    }
+  } else {
+    SubscriptValue at[maxRank];
+    instance.GetLowerBounds(at);
+    for (std::size_t j{elements}; j-- > 0; instance.IncrementSubscripts(at)) {
+      std::memcpy(instance.Element<char>(at), plan.image, bytes);
+    }
+  }
+}
+
 RT_API_ATTRS int Initialize(const Descriptor &instance,
     const typeInfo::DerivedType &derived, Terminator &terminator, bool hasStat,
     const Descriptor *errMsg) {
+  if (const ComponentPlan * plan{GetComponentPlan(derived)}) {
+    StampImage(instance, *plan);
+    return StatOk;
+  }
   const Descriptor &componentDesc{derived.component()};
   std::size_t elements{instance.Elements()};
   int stat{StatOk};
@@ -302,6 +543,22 @@ RT_API_ATTRS void Destroy(const Descriptor &descriptor, bool finalize,
   std::size_t elements{descriptor.Elements()};
   SubscriptValue at[maxRank];
   descriptor.GetLowerBounds(at);
+  if (const ComponentPlan * plan{GetComponentPlan(derived)}) {
+    for (std::size_t j{0}; j < elements;
+         ++j, descriptor.IncrementSubscripts(at)) {
+      char *element{descriptor.Element<char>(at)};
+      for (std::size_t k{0}; k < plan->allocatables; ++k) {
+        const ComponentPlan::Step &step{plan->step[k]};
+        Descriptor &d{*reinterpret_cast<Descriptor *>(element + step.offset)};
+        if (const auto *compType{step.component->derivedType()};
+            compType && !compType->noDestructionNeeded()) {
+          Destroy(d, /*finalize=*/false, *compType, terminator);
+        }
+        d.Deallocate();
+      }
+    }
+    return;
+  }
   for (std::size_t k{0}; k < myComponents; ++k) {
     const auto &comp{
         *componentDesc.ZeroBasedIndexedElement<typeInfo::Component>(k)};
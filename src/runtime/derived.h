@@ -12,10 +12,13 @@
 #define FORTRAN_RUNTIME_DERIVED_H_
 
 #include "flang/Common/api-attrs.h"
+#include <cstddef>
+#include <cstdint>
 
 namespace Fortran::runtime::typeInfo {
+class Component;
 class DerivedType;
-}
+} // namespace Fortran::runtime::typeInfo
 
 namespace Fortran::runtime {
 class Descriptor;
@@ -39,5 +42,48 @@ RT_API_ATTRS void Destroy(const Descriptor &, bool finalize,
 // entity that has a dynamic (allocatable, automatic) component.
 RT_API_ATTRS bool HasDynamicComponent(const Descriptor &);
 
+// The steps that default initialization, deep copying, and destruction
+// take for each element of a derived type, with its nonpointer components
+// of derived type expanded in place, so that array operations can run
+// them in a tight loop instead of walking the component tables (and
+// establishing descriptors for nested components) element by element.
+// Without LEN type parameters, default initialization always produces the
+// same bytes, so the plan also holds an image of a default-initialized
+// element to be copied into each new one.  That copy sets every byte of the
+// element, so its components without default initialization, whose values
+// are undefined, are left zero rather than as they were; nothing outside
+// the elements of a non-contiguous array is written.  Plans are built on
+// first use and cached for the life of the program.
+struct ComponentPlan {
+  enum class Action : std::uint8_t {
+    Allocatable, // establish; duplicate when copied; deallocate
+    Pointer, // establish as a disassociated pointer
+    Initialize, // copy `bytes` from `initialization`
+    ProcPtr, // set to `procInitialization`
+  };
+  struct Step {
+    Action action;
+    std::size_t offset; // from the start of the element
+    const typeInfo::Component *component; // Allocatable and Pointer
+    const char *initialization;
+    std::size_t bytes;
+    void (*procInitialization)();
+  };
+
+  const typeInfo::DerivedType *derived;
+  const ComponentPlan *next; // in its cache bucket
+  bool usable; // false when the type needs the general code
+  std::size_t steps; // at `step`, the Allocatable ones first
+  std::size_t allocatables;
+  const Step *step;
+  const char *image; // sizeInBytes() bytes
+};
+
+// Returns the plan for a derived type, or null when it has none: when it
+// or a component expanded into it has LEN type parameters or automatic
+// components, or when it would be too long.
+RT_API_ATTRS const ComponentPlan *GetComponentPlan(
+    const typeInfo::DerivedType &);
+
 } // namespace Fortran::runtime
 #endif // FORTRAN_RUNTIME_DERIVED_H_
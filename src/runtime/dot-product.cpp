@@ -6,7 +6,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "blas.h"
+#include "environment.h"
 #include "float.h"
+#include "summation.h"
 #include "terminator.h"
 #include "tools.h"
 #include "flang/Common/float128.h"
@@ -56,6 +59,103 @@ private:
   Result sum_{};
 };
 
+// DOT_PRODUCT of contiguous REAL or COMPLEX vectors of the same kind, with
+// several independent partial sums so that the loop can be vectorized.  This
+// changes the order of summation, so it is used only when FORT_REORDER_SUMS
+// allows it.  Element j always goes into partial sum j % lanes, and the
+// partial sums are combined pairwise, so the result depends only on the data.
+template <typename T, typename AccumType>
+static inline RT_API_ATTRS AccumType MultiLaneDotProduct(
+    const T *RESTRICT x, const T *RESTRICT y, SubscriptValue n) {
+  if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+    constexpr int lanes{8};
+    AccumType partial[lanes]{};
+    SubscriptValue j{0};
+    for (; j + lanes <= n; j += lanes) {
+      for (int l{0}; l < lanes; ++l) {
+        partial[l] += static_cast<AccumType>(x[j + l]) *
+            static_cast<AccumType>(y[j + l]);
+      }
+    }
+    for (int l{0}; j < n; ++j, ++l) {
+      partial[l] += static_cast<AccumType>(x[j]) * static_cast<AccumType>(y[j]);
+    }
+    for (int width{lanes / 2}; width > 0; width /= 2) {
+      for (int l{0}; l < width; ++l) {
+        partial[l] += partial[l + width];
+      }
+    }
+    return partial[0];
+  } else {
+    // COMPLEX: treat the vectors as arrays of interleaved real and imaginary
+    // parts.  CONJG(X)*Y = (xr*yr + xi*yi) + i*(xr*yi - xi*yr), so the real
+    // part is the sum of the products of corresponding parts, and the
+    // imaginary part comes from the products with Y's parts swapped.
+    using Part = typename T::value_type;
+    using AccumPart = typename AccumType::value_type;
+    constexpr int lanes{8}; // parts, i.e. 4 complex elements
+    const Part *RESTRICT xp{reinterpret_cast<const Part *>(x)};
+    const Part *RESTRICT yp{reinterpret_cast<const Part *>(y)};
+    AccumPart same[lanes]{}, swapped[lanes]{};
+    SubscriptValue parts{2 * n}, j{0};
+    for (; j + lanes <= parts; j += lanes) {
+      for (int l{0}; l < lanes; ++l) {
+        auto xv{static_cast<AccumPart>(xp[j + l])};
+        same[l] += xv * static_cast<AccumPart>(yp[j + l]);
+        swapped[l] += xv * static_cast<AccumPart>(yp[j + (l ^ 1)]);
+      }
+    }
+    for (int l{0}; j < parts; ++j, ++l) {
+      auto xv{static_cast<AccumPart>(xp[j])};
+      same[l] += xv * static_cast<AccumPart>(yp[j]);
+      swapped[l] += xv * static_cast<AccumPart>(yp[j ^ 1]);
+    }
+    for (int width{lanes / 2}; width > 1; width /= 2) {
+      for (int l{0}; l < width; ++l) {
+        same[l] += same[l + width];
+        swapped[l] += swapped[l + width];
+      }
+    }
+    return AccumType{same[0] + same[1], swapped[0] - swapped[1]};
+  }
+}
+
+// A term of the DOT_PRODUCT of REAL or COMPLEX vectors.  COMPLEX products
+// are formed from their parts, CONJG(X)*Y = (xr*yr + xi*yi) + i*(xr*yi -
+// xi*yr), so that they are cheap enough to vectorize.
+template <TypeCategory RCAT, typename AccumType, typename XT, typename YT>
+static inline RT_API_ATTRS AccumType DotProductTerm(const XT &x, const YT &y) {
+  if constexpr (RCAT == TypeCategory::Complex) {
+    AccumType xv{static_cast<AccumType>(x)}, yv{static_cast<AccumType>(y)};
+    return AccumType{xv.real() * yv.real() + xv.imag() * yv.imag(),
+        xv.real() * yv.imag() - xv.imag() * yv.real()};
+  } else {
+    return static_cast<AccumType>(x) * static_cast<AccumType>(y);
+  }
+}
+
+// DOT_PRODUCT of contiguous REAL or COMPLEX vectors by Summation::Kahan or
+// Summation::Pairwise; the parts of COMPLEX sums are compensated or paired
+// independently.
+template <TypeCategory RCAT, typename AccumType, typename XT, typename YT>
+static RT_API_ATTRS AccumType KahanDotProduct(
+    const XT *RESTRICT x, const YT *RESTRICT y, SubscriptValue n) {
+  KahanSum<AccumType> sum;
+  for (SubscriptValue j{0}; j < n; ++j) {
+    sum.Add(DotProductTerm<RCAT, AccumType>(x[j], y[j]));
+  }
+  return sum.Result();
+}
+template <TypeCategory RCAT, typename AccumType, typename XT, typename YT>
+static RT_API_ATTRS AccumType PairwiseDotProduct(
+    const XT *RESTRICT x, const YT *RESTRICT y, SubscriptValue n) {
+  PairwiseSum<AccumType> sum;
+  sum.AddTerms(n, [x, y](SubscriptValue j) {
+    return DotProductTerm<RCAT, AccumType>(x[j], y[j]);
+  });
+  return sum.Result();
+}
+
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT>
 static inline RT_API_ATTRS CppTypeFor<RCAT, RKIND> DoDotProduct(
     const Descriptor &x, const Descriptor &y, Terminator &terminator) {
@@ -71,12 +171,19 @@ static inline RT_API_ATTRS CppTypeFor<RCAT, RKIND> DoDotProduct(
     if (x.GetDimension(0).ByteStride() == sizeof(XT) &&
         y.GetDimension(0).ByteStride() == sizeof(YT)) {
       // Contiguous numeric vectors
+      Summation summation{RCAT == TypeCategory::Integer
+              ? Summation::Default
+              : executionEnvironment.summation};
       if constexpr (std::is_same_v<XT, YT>) {
         // Contiguous homogeneous numeric vectors
-        if constexpr (std::is_same_v<XT, float>) {
-          // TODO: call BLAS-1 SDOT or SDSDOT
-        } else if constexpr (std::is_same_v<XT, double>) {
-          // TODO: call BLAS-1 DDOT
+        if constexpr (IsBlasType<XT> && std::is_same_v<XT, Result>) {
+          // S/DDOT, when registered
+          if (summation == Summation::Default) {
+            if (auto dot{BlasDotProduct<XT>(
+                    n, x.OffsetElement<XT>(0), y.OffsetElement<YT>(0))}) {
+              return *dot;
+            }
+          }
         } else if constexpr (std::is_same_v<XT, std::complex<float>>) {
           // TODO: call BLAS-1 CDOTC
         } else if constexpr (std::is_same_v<XT, std::complex<double>>) {
@@ -86,6 +193,27 @@ static inline RT_API_ATTRS CppTypeFor<RCAT, RKIND> DoDotProduct(
       XT *xp{x.OffsetElement<XT>(0)};
       YT *yp{y.OffsetElement<YT>(0)};
       using AccumType = AccumulationType<RCAT, RKIND>;
+      if constexpr (RCAT == TypeCategory::Real ||
+          RCAT == TypeCategory::Complex) {
+        switch (summation) {
+        case Summation::Default:
+          if constexpr (std::is_same_v<XT, YT> && (RKIND == 4 || RKIND == 8)) {
+            if (executionEnvironment.reorderSums) {
+              return static_cast<Result>(
+                  MultiLaneDotProduct<XT, AccumType>(xp, yp, n));
+            }
+          }
+          break;
+        case Summation::Naive:
+          break;
+        case Summation::Kahan:
+          return static_cast<Result>(
+              KahanDotProduct<RCAT, AccumType>(xp, yp, n));
+        case Summation::Pairwise:
+          return static_cast<Result>(
+              PairwiseDotProduct<RCAT, AccumType>(xp, yp, n));
+        }
+      }
       AccumType accum{};
       if constexpr (RCAT == TypeCategory::Complex) {
         for (SubscriptValue j{0}; j < n; ++j) {
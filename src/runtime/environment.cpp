@@ -143,6 +143,54 @@ void ExecutionEnvironment::Configure(int ac, const char *av[],
     }
   }
 
+  if (auto *x{std::getenv("FORT_NUM_THREADS")}) {
+    char *end;
+    auto n{std::strtol(x, &end, 10)};
+    if (n > 0 && n <= 1024 && *end == '\0') {
+      workerThreads = n;
+    } else {
+      std::fprintf(stderr,
+          "Fortran runtime: FORT_NUM_THREADS=%s is invalid; ignored\n", x);
+    }
+  }
+
+  // FORT_REORDER_SUMS=1 lets reductions like DOT_PRODUCT sum in an order
+  // that is faster but may round differently from left-to-right summation.
+  if (auto *x{std::getenv("FORT_REORDER_SUMS")}) {
+    char *end;
+    auto n{std::strtol(x, &end, 10)};
+    if (n >= 0 && n <= 1 && *end == '\0') {
+      reorderSums = n != 0;
+    } else {
+      std::fprintf(stderr,
+          "Fortran runtime: FORT_REORDER_SUMS=%s is invalid; ignored\n", x);
+    }
+  }
+
+  // FORT_SUMMATION=NAIVE, KAHAN, or PAIRWISE selects how SUM, DOT_PRODUCT,
+  // and NORM2 add up REAL and COMPLEX terms.
+  if (auto *x{std::getenv("FORT_SUMMATION")}) {
+    static const char *keywords[]{
+        "DEFAULT", "NAIVE", "KAHAN", "PAIRWISE", nullptr};
+    switch (IdentifyValue(x, std::strlen(x), keywords)) {
+    case 0:
+      summation = Summation::Default;
+      break;
+    case 1:
+      summation = Summation::Naive;
+      break;
+    case 2:
+      summation = Summation::Kahan;
+      break;
+    case 3:
+      summation = Summation::Pairwise;
+      break;
+    default:
+      std::fprintf(stderr,
+          "Fortran runtime: FORT_SUMMATION=%s is invalid; ignored\n", x);
+    }
+  }
+
   // TODO: Set RP/ROUND='PROCESSOR_DEFINED' from environment
 }
 
@@ -11,6 +11,7 @@
 
 #include "flang/Common/optional.h"
 #include "flang/Decimal/decimal.h"
+#include "flang/Runtime/reduction.h"
 
 struct EnvironmentDefaultList;
 
@@ -56,6 +57,9 @@ struct ExecutionEnvironment {
   bool noStopMessage{false}; // NO_STOP_MESSAGE=1 inhibits "Fortran STOP"
   bool defaultUTF8{false}; // DEFAULT_UTF8
   bool checkPointerDeallocation{true}; // FORT_CHECK_POINTER_DEALLOCATION
+  int workerThreads{1}; // FORT_NUM_THREADS
+  bool reorderSums{false}; // FORT_REORDER_SUMS
+  Summation summation{Summation::Default}; // FORT_SUMMATION
 };
 
 RT_OFFLOAD_VAR_GROUP_BEGIN
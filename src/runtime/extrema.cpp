@@ -11,6 +11,7 @@
 // NORM2 using common infrastructure.
 
 #include "reduction-templates.h"
+#include "summation.h"
 #include "flang/Common/float128.h"
 #include "flang/Runtime/character.h"
 #include "flang/Runtime/reduction.h"
@@ -18,6 +19,7 @@
 #include <cfloat>
 #include <cinttypes>
 #include <cmath>
+#include <limits>
 #include <type_traits>
 
 namespace Fortran::runtime {
@@ -40,6 +42,110 @@ template <typename T, bool IS_MAX, bool BACK> struct NumericCompare {
   }
 };
 
+// MAXLOC & MINLOC of contiguous numeric data without MASK= compare the
+// elements in independent lanes that the compiler can vectorize, each lane
+// keeping its own best value and the element number at which it was seen.
+// An element replaces a lane's best value when it compares strictly better,
+// or equal with BACK=, so NaNs are never chosen; the lanes are resolved by
+// value and then by element number.  Returns false when no element has
+// been chosen (all are NaN or equal to the initial value), leaving the
+// result to ExtremumLocAccumulator.
+template <typename T, bool IS_MAX, bool BACK>
+inline RT_API_ATTRS bool ContiguousExtremumLoc(
+    const T *x, std::size_t n, std::size_t &at) {
+  // Lane element numbers are relative to the start of a block of elements
+  // and are as wide as T so that they vectorize alongside the values.
+  using Index = std::conditional_t<sizeof(T) == 8, std::uint64_t,
+      std::uint32_t>;
+  constexpr int lanes{8};
+  constexpr std::size_t blockElements{std::size_t{1} << 30};
+  constexpr Index none{~Index{0}};
+  using Limits = std::numeric_limits<T>;
+  constexpr T initial{Limits::has_infinity
+          ? (IS_MAX ? -Limits::infinity() : Limits::infinity())
+          : (IS_MAX ? Limits::lowest() : Limits::max())};
+  auto isBetter{[](const T &value, const T &best) {
+    if constexpr (IS_MAX) {
+      return BACK ? value >= best : value > best;
+    } else {
+      return BACK ? value <= best : value < best;
+    }
+  }};
+  // Is (value, j) to be preferred over (best, k) when both were chosen?
+  auto isPreferred{[](const T &value, std::size_t j, const T &best,
+                       std::size_t k) {
+    if (value == best) {
+      return BACK ? j > k : j < k;
+    } else {
+      return IS_MAX ? value > best : value < best;
+    }
+  }};
+  bool found{false};
+  T result{initial};
+  for (std::size_t start{0}; start < n; start += blockElements) {
+    const T *block{x + start};
+    Index m{static_cast<Index>(std::min(n - start, blockElements))};
+    T best[lanes];
+    Index where[lanes];
+    for (int l{0}; l < lanes; ++l) {
+      best[l] = initial;
+      where[l] = none;
+    }
+    Index j{0};
+    for (; j + lanes <= m; j += lanes) {
+      for (int l{0}; l < lanes; ++l) {
+        T value{block[j + l]};
+        bool better{isBetter(value, best[l])};
+        best[l] = better ? value : best[l];
+        where[l] = better ? static_cast<Index>(j + l) : where[l];
+      }
+    }
+    for (int l{0}; j < m; ++j, ++l) {
+      if (isBetter(block[j], best[l])) {
+        best[l] = block[j];
+        where[l] = j;
+      }
+    }
+    for (int l{0}; l < lanes; ++l) {
+      if (where[l] != none &&
+          (!found || isPreferred(best[l], start + where[l], result, at))) {
+        found = true;
+        result = best[l];
+        at = start + where[l];
+      }
+    }
+  }
+  return found;
+}
+
+// Uses ContiguousExtremumLoc() for MAXLOC/MINLOC when possible.
+template <TypeCategory CAT, int KIND, bool IS_MAX>
+inline RT_API_ATTRS bool ContiguousMaxOrMinLoc(Descriptor &result,
+    const Descriptor &x, int kind, const Descriptor *mask, bool back,
+    Terminator &terminator) {
+  using Type = CppTypeFor<CAT, KIND>;
+  if constexpr (std::numeric_limits<Type>::has_infinity ||
+      std::is_integral_v<Type>) {
+    if ((mask && (mask->rank() > 0 || !IsLogicalScalarTrue(*mask))) ||
+        !x.IsContiguous() || x.Elements() == 0) {
+      return false;
+    }
+    std::size_t at{0};
+    const Type *data{x.OffsetElement<Type>()};
+    if (!(back ? ContiguousExtremumLoc<Type, IS_MAX, true>(
+                     data, x.Elements(), at)
+               : ContiguousExtremumLoc<Type, IS_MAX, false>(
+                     data, x.Elements(), at))) {
+      return false;
+    }
+    ApplyIntegerKind<ElementLocationHelper, void>(
+        kind, terminator, result, x, at);
+    return true;
+  } else {
+    return false;
+  }
+}
+
 template <typename T, bool IS_MAX, bool BACK> class CharacterCompare {
 public:
   using Type = T;
@@ -187,6 +293,10 @@ inline RT_API_ATTRS void TotalNumericMaxOrMinLoc(const char *intrinsic,
   }
   CheckIntegerKind(terminator, kind, intrinsic);
   RUNTIME_CHECK(terminator, TypeCode(CAT, KIND) == x.type());
+  if (ContiguousMaxOrMinLoc<CAT, KIND, IS_MAXVAL>(
+          result, x, kind, mask, back, terminator)) {
+    return;
+  }
   DoMaxOrMinLoc<CAT, KIND, IS_MAXVAL, NumericCompare>(
       intrinsic, result, x, kind, source, line, mask, back);
 }
@@ -456,6 +566,44 @@ public:
   RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
     return Accumulate(*array_.Element<A>(at));
   }
+  template <typename A>
+  RT_API_ATTRS bool AccumulateContiguous(const A *x, SubscriptValue n) {
+    // Take elements one at a time until there's an extremum that is not a
+    // NaN; from then on, NaNs never compare greater or less, and the rest
+    // can be reduced in independent lanes that vectorize.
+    SubscriptValue j{0};
+    for (; j < n && (!any_ || extremum_ != extremum_); ++j) {
+      Accumulate(x[j]);
+    }
+    constexpr int lanes{8};
+    if (n - j >= lanes) {
+      Type lane[lanes];
+      for (int l{0}; l < lanes; ++l) {
+        lane[l] = extremum_;
+      }
+      for (; j + lanes <= n; j += lanes) {
+        for (int l{0}; l < lanes; ++l) {
+          if constexpr (IS_MAXVAL) {
+            lane[l] = x[j + l] > lane[l] ? x[j + l] : lane[l];
+          } else {
+            lane[l] = x[j + l] < lane[l] ? x[j + l] : lane[l];
+          }
+        }
+      }
+      for (int l{0}; l < lanes; ++l) {
+        Accumulate(lane[l]);
+      }
+    }
+    for (; j < n; ++j) {
+      Accumulate(x[j]);
+    }
+    return true;
+  }
+  RT_API_ATTRS void Merge(const NumericExtremumAccumulator &that) {
+    if (that.any_) {
+      Accumulate(that.extremum_);
+    }
+  }
 
 private:
   const Descriptor &array_;
@@ -722,19 +870,16 @@ RT_EXT_API_GROUP_BEGIN
 // TODO: REAL(2 & 3)
 CppTypeFor<TypeCategory::Real, 4> RTDEF(Norm2_4)(
     const Descriptor &x, const char *source, int line, int dim) {
-  return GetTotalReduction<TypeCategory::Real, 4>(
-      x, source, line, dim, nullptr, Norm2Accumulator<4>{x}, "NORM2");
+  return TotalNorm2<4>(x, source, line, dim);
 }
 CppTypeFor<TypeCategory::Real, 8> RTDEF(Norm2_8)(
     const Descriptor &x, const char *source, int line, int dim) {
-  return GetTotalReduction<TypeCategory::Real, 8>(
-      x, source, line, dim, nullptr, Norm2Accumulator<8>{x}, "NORM2");
+  return TotalNorm2<8>(x, source, line, dim);
 }
 #if LDBL_MANT_DIG == 64
 CppTypeFor<TypeCategory::Real, 10> RTDEF(Norm2_10)(
     const Descriptor &x, const char *source, int line, int dim) {
-  return GetTotalReduction<TypeCategory::Real, 10>(
-      x, source, line, dim, nullptr, Norm2Accumulator<10>{x}, "NORM2");
+  return TotalNorm2<10>(x, source, line, dim);
 }
 #endif
 
@@ -751,6 +896,173 @@ void RTDEF(Norm2Dim)(Descriptor &result, const Descriptor &x, int dim,
   }
 }
 
+RT_EXT_API_GROUP_END
+} // extern "C"
+
+// MINVAL, MAXVAL, SUM, and NORM2 in one pass
+
+// Feeds each element to the accumulators of the requested statistics.
+// Contiguous runs are passed to each of them a slice at a time, so that
+// their own vectorized loops read data that is still in the cache.
+template <int KIND, Summation SUM_SUMMATION, Summation NORM2_SUMMATION>
+class MinMaxSumNorm2Accumulator {
+public:
+  using Type = CppTypeFor<TypeCategory::Real, KIND>;
+  RT_API_ATTRS MinMaxSumNorm2Accumulator(const Descriptor &array,
+      bool wantMin, bool wantMax, bool wantSum, bool wantNorm2)
+      : array_{array}, wantMin_{wantMin}, wantMax_{wantMax},
+        wantSum_{wantSum}, wantNorm2_{wantNorm2} {}
+  RT_API_ATTRS void Reinitialize() {
+    min_.Reinitialize();
+    max_.Reinitialize();
+    sum_.Reinitialize();
+    norm2_.Reinitialize();
+  }
+  RT_API_ATTRS void GetResults(
+      Type *minval, Type *maxval, Type *sum, Type *norm2) const {
+    if (minval) {
+      min_.GetResult(minval);
+    }
+    if (maxval) {
+      max_.GetResult(maxval);
+    }
+    if (sum) {
+      sum_.GetResult(sum);
+    }
+    if (norm2) {
+      norm2_.GetResult(norm2);
+    }
+  }
+  RT_API_ATTRS bool Accumulate(Type x) {
+    if (wantMin_) {
+      min_.Accumulate(x);
+    }
+    if (wantMax_) {
+      max_.Accumulate(x);
+    }
+    if (wantSum_) {
+      sum_.Accumulate(x);
+    }
+    if (wantNorm2_) {
+      norm2_.Accumulate(x);
+    }
+    return true;
+  }
+  template <typename A>
+  RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
+    return Accumulate(*array_.Element<A>(at));
+  }
+  template <typename A>
+  RT_API_ATTRS bool AccumulateContiguous(const A *x, SubscriptValue n) {
+    for (SubscriptValue j{0}; j < n; j += sliceElements) {
+      SubscriptValue slice{std::min(sliceElements, n - j)};
+      if (wantMin_) {
+        min_.AccumulateContiguous(x + j, slice);
+      }
+      if (wantMax_) {
+        max_.AccumulateContiguous(x + j, slice);
+      }
+      if (wantSum_) {
+        sum_.AccumulateContiguous(x + j, slice);
+      }
+      if (wantNorm2_) {
+        norm2_.AccumulateContiguous(x + j, slice);
+      }
+    }
+    return true;
+  }
+  RT_API_ATTRS void Merge(const MinMaxSumNorm2Accumulator &that) {
+    min_.Merge(that.min_);
+    max_.Merge(that.max_);
+    sum_.Merge(that.sum_);
+    norm2_.Merge(that.norm2_);
+  }
+
+private:
+  // 8KiB of REAL(8); a multiple of the pairwise summation block.
+  static constexpr SubscriptValue sliceElements{1024};
+
+  const Descriptor &array_;
+  bool wantMin_, wantMax_, wantSum_, wantNorm2_;
+  NumericExtremumAccumulator<TypeCategory::Real, KIND, false> min_{array_};
+  NumericExtremumAccumulator<TypeCategory::Real, KIND, true> max_{array_};
+  RealSumAccumulator<Type, SUM_SUMMATION> sum_{array_};
+  Norm2Accumulator<KIND, NORM2_SUMMATION> norm2_{array_};
+};
+
+template <int KIND, Summation SUM_SUMMATION, Summation NORM2_SUMMATION>
+static RT_API_ATTRS void MinMaxSumNorm2(
+    CppTypeFor<TypeCategory::Real, KIND> *minval,
+    CppTypeFor<TypeCategory::Real, KIND> *maxval,
+    CppTypeFor<TypeCategory::Real, KIND> *sum,
+    CppTypeFor<TypeCategory::Real, KIND> *norm2, const Descriptor &x,
+    Terminator &terminator, const Descriptor *mask) {
+  MinMaxSumNorm2Accumulator<KIND, SUM_SUMMATION, NORM2_SUMMATION> accumulator{
+      x, minval != nullptr, maxval != nullptr, sum != nullptr,
+      norm2 != nullptr};
+  DoTotalReduction<CppTypeFor<TypeCategory::Real, KIND>>(
+      x, 0, mask, accumulator, "MINVAL/MAXVAL/SUM/NORM2", terminator);
+  accumulator.GetResults(minval, maxval, sum, norm2);
+}
+
+template <int KIND>
+static RT_API_ATTRS void MinMaxSumNorm2(
+    CppTypeFor<TypeCategory::Real, KIND> *minval,
+    CppTypeFor<TypeCategory::Real, KIND> *maxval,
+    CppTypeFor<TypeCategory::Real, KIND> *sum,
+    CppTypeFor<TypeCategory::Real, KIND> *norm2, const Descriptor &x,
+    const char *source, int line, const Descriptor *mask) {
+  Terminator terminator{source, line};
+  RUNTIME_CHECK(terminator, TypeCode(TypeCategory::Real, KIND) == x.type());
+  // The switch selects SUM's method, as in sum.cpp; NORM2 picks up the
+  // method through its own accumulator's argument, which differs only when
+  // none has been selected, as NORM2's default is naive summation.
+  switch (GetSummation(Summation::Default)) {
+  case Summation::Naive:
+    MinMaxSumNorm2<KIND, Summation::Naive, Summation::Naive>(
+        minval, maxval, sum, norm2, x, terminator, mask);
+    break;
+  case Summation::Kahan:
+    MinMaxSumNorm2<KIND, Summation::Kahan, Summation::Kahan>(
+        minval, maxval, sum, norm2, x, terminator, mask);
+    break;
+  case Summation::Pairwise:
+    MinMaxSumNorm2<KIND, Summation::Pairwise, Summation::Pairwise>(
+        minval, maxval, sum, norm2, x, terminator, mask);
+    break;
+  default:
+    MinMaxSumNorm2<KIND, Summation::Kahan, Summation::Naive>(
+        minval, maxval, sum, norm2, x, terminator, mask);
+  }
+}
+
+extern "C" {
+RT_EXT_API_GROUP_BEGIN
+
+void RTDEF(MinMaxSumNorm2Real4)(CppTypeFor<TypeCategory::Real, 4> *minval,
+    CppTypeFor<TypeCategory::Real, 4> *maxval,
+    CppTypeFor<TypeCategory::Real, 4> *sum,
+    CppTypeFor<TypeCategory::Real, 4> *norm2, const Descriptor &x,
+    const char *source, int line, const Descriptor *mask) {
+  MinMaxSumNorm2<4>(minval, maxval, sum, norm2, x, source, line, mask);
+}
+void RTDEF(MinMaxSumNorm2Real8)(CppTypeFor<TypeCategory::Real, 8> *minval,
+    CppTypeFor<TypeCategory::Real, 8> *maxval,
+    CppTypeFor<TypeCategory::Real, 8> *sum,
+    CppTypeFor<TypeCategory::Real, 8> *norm2, const Descriptor &x,
+    const char *source, int line, const Descriptor *mask) {
+  MinMaxSumNorm2<8>(minval, maxval, sum, norm2, x, source, line, mask);
+}
+#if LDBL_MANT_DIG == 64
+void RTDEF(MinMaxSumNorm2Real10)(CppTypeFor<TypeCategory::Real, 10> *minval,
+    CppTypeFor<TypeCategory::Real, 10> *maxval,
+    CppTypeFor<TypeCategory::Real, 10> *sum,
+    CppTypeFor<TypeCategory::Real, 10> *norm2, const Descriptor &x,
+    const char *source, int line, const Descriptor *mask) {
+  MinMaxSumNorm2<10>(minval, maxval, sum, norm2, x, source, line, mask);
+}
+#endif
+
 RT_EXT_API_GROUP_END
 } // extern "C"
 } // namespace Fortran::runtime
@@ -14,6 +14,7 @@
 #include "flang/Runtime/reduction.h"
 #include <cinttypes>
 #include <complex>
+#include <cstring>
 
 namespace Fortran::runtime {
 
@@ -80,6 +81,107 @@ struct LogicalEquivalence {
   }
 };
 
+// FINDLOC of contiguous data without MASK= tests a block of elements at a
+// time for any hit, with comparisons that the compiler can vectorize, and
+// looks for the hit within a block only once it has one.  Returns the
+// zero-based element number of the first (or, with BACK=, last) element
+// for which `isHit` is true, or `n` when there is none.
+template <typename T, typename PREDICATE>
+inline RT_API_ATTRS std::size_t FindContiguous(
+    const T *x, std::size_t n, bool back, PREDICATE isHit) {
+  constexpr std::size_t block{32};
+  auto anyHit{[&](std::size_t start) {
+    bool any{false};
+    for (std::size_t j{start}; j < start + block; ++j) {
+      any |= isHit(x[j]);
+    }
+    return any;
+  }};
+  if (back) {
+    std::size_t j{n};
+    for (; j >= block && !anyHit(j - block); j -= block) {
+    }
+    while (j-- > 0) {
+      if (isHit(x[j])) {
+        return j;
+      }
+    }
+  } else {
+    std::size_t j{0};
+    for (; j + block <= n && !anyHit(j); j += block) {
+    }
+    for (; j < n; ++j) {
+      if (isHit(x[j])) {
+        return j;
+      }
+    }
+  }
+  return n;
+}
+
+// Returns true and stores the result when FINDLOC can search the elements
+// of `x` as a contiguous sequence of T.
+template <typename T, typename PREDICATE>
+inline RT_API_ATTRS bool ContiguousFindloc(Descriptor &result,
+    const Descriptor &x, int kind, const Descriptor *mask, bool back,
+    Terminator &terminator, PREDICATE isHit) {
+  if ((mask && (mask->rank() > 0 || !IsLogicalScalarTrue(*mask))) ||
+      !x.IsContiguous()) {
+    return false;
+  }
+  std::size_t at{
+      FindContiguous(x.OffsetElement<T>(), x.Elements(), back, isHit)};
+  ApplyIntegerKind<ElementLocationHelper, void>(
+      kind, terminator, result, x, at);
+  return true;
+}
+
+// CHARACTER FINDLOC of contiguous data without MASK= checks the first
+// character of each element before comparing the rest of it.  The
+// comparison is the blank-padded one of CharacterEquality.
+template <int KIND>
+inline RT_API_ATTRS std::size_t FindContiguousCharacter(const Descriptor &x,
+    const Descriptor &target, bool back) {
+  using Type = CppTypeFor<TypeCategory::Character, KIND>;
+  std::size_t n{x.Elements()};
+  std::size_t xLen{x.ElementBytes() / KIND};
+  std::size_t targetLen{target.ElementBytes() / KIND};
+  const Type *xData{x.OffsetElement<Type>()};
+  const Type *targetData{target.OffsetElement<Type>()};
+  auto allBlanks{[](const Type *p, std::size_t len) {
+    for (std::size_t j{0}; j < len; ++j) {
+      if (p[j] != static_cast<Type>(' ')) {
+        return false;
+      }
+    }
+    return true;
+  }};
+  std::size_t common{std::min(xLen, targetLen)};
+  if (!allBlanks(targetData + common, targetLen - common)) {
+    return n; // the target's tail can't match blank padding
+  }
+  auto isHit{[&](std::size_t j) {
+    const Type *element{xData + j * xLen};
+    return (common == 0 || element[0] == targetData[0]) &&
+        std::memcmp(element, targetData, common * KIND) == 0 &&
+        allBlanks(element + common, xLen - common);
+  }};
+  if (back) {
+    for (std::size_t j{n}; j-- > 0;) {
+      if (isHit(j)) {
+        return j;
+      }
+    }
+  } else {
+    for (std::size_t j{0}; j < n; ++j) {
+      if (isHit(j)) {
+        return j;
+      }
+    }
+  }
+  return n;
+}
+
 template <typename EQUALITY> class LocationAccumulator {
 public:
   RT_API_ATTRS LocationAccumulator(
@@ -132,6 +234,22 @@ struct TotalNumericFindlocHelper {
     RT_API_ATTRS void operator()(Descriptor &result, const Descriptor &x,
         const Descriptor &target, int kind, int dim, const Descriptor *mask,
         bool back, Terminator &terminator) const {
+      if constexpr (XCAT == TARGET_CAT &&
+          (XCAT == TypeCategory::Integer || XCAT == TypeCategory::Real)) {
+        // An element equals the target if and only if it equals the target
+        // converted to the element's type, and that conversion is exact.
+        using Type = CppTypeFor<XCAT, XKIND>;
+        using TargetType = CppTypeFor<TARGET_CAT, TARGET_KIND>;
+        TargetType value{*target.OffsetElement<TargetType>()};
+        Type key{static_cast<Type>(value)};
+        bool exact{static_cast<TargetType>(key) == value};
+        if (ContiguousFindloc<Type>(result, x, kind, mask, back, terminator,
+                [key, exact](const Type &element) {
+                  return exact && element == key;
+                })) {
+          return;
+        }
+      }
       using Eq = Equality<XCAT, XKIND, TARGET_CAT, TARGET_KIND>;
       using Accumulator = LocationAccumulator<Eq>;
       Accumulator accumulator{x, target, back};
@@ -183,6 +301,12 @@ template <int KIND> struct CharacterFindlocHelper {
   RT_API_ATTRS void operator()(Descriptor &result, const Descriptor &x,
       const Descriptor &target, int kind, const Descriptor *mask, bool back,
       Terminator &terminator) {
+    if ((!mask || (mask->rank() == 0 && IsLogicalScalarTrue(*mask))) &&
+        x.IsContiguous()) {
+      ApplyIntegerKind<ElementLocationHelper, void>(kind, terminator, result,
+          x, FindContiguousCharacter<KIND>(x, target, back));
+      return;
+    }
     using Accumulator = LocationAccumulator<CharacterEquality<KIND>>;
     Accumulator accumulator{x, target, back};
     DoTotalReduction<void>(x, 0, mask, accumulator, "FINDLOC", terminator);
@@ -191,9 +315,26 @@ template <int KIND> struct CharacterFindlocHelper {
   }
 };
 
+// A LOGICAL element is searched for as an integer of the same size, which
+// is nonzero if and only if the LOGICAL value is true.
+template <int KIND> struct ContiguousLogicalFindlocHelper {
+  RT_API_ATTRS bool operator()(Descriptor &result, const Descriptor &x,
+      bool value, int kind, const Descriptor *mask, bool back,
+      Terminator &terminator) const {
+    using Type = CppTypeFor<TypeCategory::Integer, KIND>;
+    return ContiguousFindloc<Type>(result, x, kind, mask, back, terminator,
+        [value](const Type &element) { return (element != 0) == value; });
+  }
+};
+
 static RT_API_ATTRS void LogicalFindlocHelper(Descriptor &result,
     const Descriptor &x, const Descriptor &target, int kind,
     const Descriptor *mask, bool back, Terminator &terminator) {
+  if (ApplyLogicalKind<ContiguousLogicalFindlocHelper, bool>(
+          static_cast<int>(x.ElementBytes()), terminator, result, x,
+          IsLogicalScalarTrue(target), kind, mask, back, terminator)) {
+    return;
+  }
   using Accumulator = LocationAccumulator<LogicalEquivalence>;
   Accumulator accumulator{x, target, back};
   DoTotalReduction<void>(x, 0, mask, accumulator, "FINDLOC", terminator);
@@ -0,0 +1,307 @@
+//===-- runtime/matmul-gemm.h -----------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Cache-blocked, register-tiled matrix*matrix multiplication used by MATMUL
+// for contiguous REAL and COMPLEX operands of the same type and kind.
+//
+// The loop structure is the usual packed GEMM decomposition:
+//   DO 1 JC = 1, NCOLS, NC           ! NC columns of Y (L3-resident panel)
+//    DO 1 PC = 1, N, KC              ! pack Y(PC:PC+KC-1,JC:JC+NC-1)
+//     DO 1 IC = 1, NROWS, MC         ! pack X(IC:IC+MC-1,PC:PC+KC-1) (L2)
+//      DO 1 JR = JC, JC+NC-1, NR     ! NR-column micro-panel of packed Y (L1)
+//       DO 1 IR = IC, IC+MC-1, MR    ! MR-row micro-panel of packed X
+//   1    RES(IR:IR+MR-1,JR:JR+NR-1) += micro-kernel product (registers)
+// Packed micro-panels are zero-padded to full MR and NR tiles so that the
+// micro-kernel has no edge cases; only the store into the result is trimmed.
+// COMPLEX operands are packed with their real and imaginary parts split into
+// separate MR/NR-wide rows so that the micro-kernel is a plain real FMA loop.
+//
+// Each result element is always accumulated in the same order (ascending K
+// within a KC slice, slices in ascending order), independently of where its
+// row or column falls within a block.  This lets large products be split
+// into tile-aligned slices computed by the runtime's worker threads without
+// changing the result.
+
+#ifndef FORTRAN_RUNTIME_MATMUL_GEMM_H_
+#define FORTRAN_RUNTIME_MATMUL_GEMM_H_
+
+#include "terminator.h"
+#include "worker-pool.h"
+#include "flang/Common/optional.h"
+#include "flang/Runtime/c-or-cpp.h"
+#include "flang/Runtime/descriptor.h"
+#include "flang/Runtime/memory.h"
+#include <algorithm>
+#include <complex>
+#include <type_traits>
+
+namespace Fortran::runtime {
+
+template <typename T> struct GemmTraits {
+  using Real = T;
+  static constexpr bool isComplex{false};
+};
+template <typename R> struct GemmTraits<std::complex<R>> {
+  using Real = R;
+  static constexpr bool isComplex{true};
+};
+
+// Types for which the blocked kernel is instantiated; these correspond to
+// the BLAS S/D/C/Z GEMM variants.
+template <typename T>
+constexpr bool IsBlockedGemmType{std::is_same_v<T, float> ||
+    std::is_same_v<T, double> || std::is_same_v<T, std::complex<float>> ||
+    std::is_same_v<T, std::complex<double>>};
+
+// Tile sizes.  The micro-kernel keeps an MR x NR tile of the result in
+// registers (64 bytes of reals per column); a packed MC x KC block of X is
+// sized for L2 (~256KiB) and a packed KC x NC panel of Y for L3 (~4MiB).
+template <typename T> struct GemmBlocking {
+  using Real = typename GemmTraits<T>::Real;
+  static constexpr SubscriptValue MR{
+      64 / (sizeof(Real) * (GemmTraits<T>::isComplex ? 2 : 1))};
+  static constexpr SubscriptValue NR{4};
+  static constexpr SubscriptValue KC{256};
+  static constexpr SubscriptValue MC{1024 / sizeof(T)};
+  static constexpr SubscriptValue NC{16384 / sizeof(T)};
+  static_assert(MC % MR == 0 && NC % NR == 0);
+};
+
+// Products smaller than this (in multiply-adds) are not worth packing.
+constexpr std::size_t blockedGemmMinimumWork{32 * 32 * 32};
+
+// Matrix products are split across worker threads only when each thread
+// gets at least this many multiply-adds.
+constexpr std::size_t parallelMatmulWorkPerThread{64 * 64 * 64};
+
+// Returns the distance in elements between consecutive columns of a matrix
+// operand: `contiguousStride` when its columns are adjacent, else the byte
+// stride (which may encode a negative value) converted to elements, or
+// nothing when it is not a whole number of elements.
+template <typename T>
+inline RT_API_ATTRS Fortran::common::optional<SubscriptValue> GetColumnStride(
+    Fortran::common::optional<std::size_t> columnByteStride,
+    SubscriptValue contiguousStride) {
+  if (!columnByteStride) {
+    return contiguousStride;
+  }
+  auto bytes{static_cast<SubscriptValue>(*columnByteStride)};
+  constexpr auto elementBytes{static_cast<SubscriptValue>(sizeof(T))};
+  if (bytes % elementBytes != 0) {
+    return Fortran::common::nullopt;
+  }
+  return bytes / elementBytes;
+}
+
+// Packs the mc x kc block of A, whose element (i,p) is at a[i*rs + p*cs],
+// into consecutive MR-row micro-panels, each stored K-major.
+template <typename T>
+inline RT_API_ATTRS void PackGemmA(typename GemmTraits<T>::Real *RESTRICT to,
+    const T *RESTRICT a, SubscriptValue mc, SubscriptValue kc,
+    SubscriptValue rs, SubscriptValue cs) {
+  constexpr SubscriptValue MR{GemmBlocking<T>::MR};
+  for (SubscriptValue ir{0}; ir < mc; ir += MR) {
+    SubscriptValue m{std::min(MR, mc - ir)};
+    for (SubscriptValue p{0}; p < kc; ++p) {
+      const T *RESTRICT from{a + ir * rs + p * cs};
+      if constexpr (GemmTraits<T>::isComplex) {
+        for (SubscriptValue i{0}; i < m; ++i) {
+          to[i] = from[i * rs].real();
+          to[MR + i] = from[i * rs].imag();
+        }
+        for (SubscriptValue i{m}; i < MR; ++i) {
+          to[i] = to[MR + i] = 0;
+        }
+        to += 2 * MR;
+      } else {
+        for (SubscriptValue i{0}; i < m; ++i) {
+          to[i] = from[i * rs];
+        }
+        for (SubscriptValue i{m}; i < MR; ++i) {
+          to[i] = 0;
+        }
+        to += MR;
+      }
+    }
+  }
+}
+
+// Packs the kc x nc panel of B, whose element (p,j) is at b[p*rs + j*cs],
+// into consecutive NR-column micro-panels, each stored K-major.
+template <typename T>
+inline RT_API_ATTRS void PackGemmB(typename GemmTraits<T>::Real *RESTRICT to,
+    const T *RESTRICT b, SubscriptValue kc, SubscriptValue nc,
+    SubscriptValue rs, SubscriptValue cs) {
+  constexpr SubscriptValue NR{GemmBlocking<T>::NR};
+  for (SubscriptValue jr{0}; jr < nc; jr += NR) {
+    SubscriptValue n{std::min(NR, nc - jr)};
+    for (SubscriptValue p{0}; p < kc; ++p) {
+      const T *RESTRICT from{b + p * rs + jr * cs};
+      if constexpr (GemmTraits<T>::isComplex) {
+        for (SubscriptValue j{0}; j < n; ++j) {
+          to[j] = from[j * cs].real();
+          to[NR + j] = from[j * cs].imag();
+        }
+        for (SubscriptValue j{n}; j < NR; ++j) {
+          to[j] = to[NR + j] = 0;
+        }
+        to += 2 * NR;
+      } else {
+        for (SubscriptValue j{0}; j < n; ++j) {
+          to[j] = from[j * cs];
+        }
+        for (SubscriptValue j{n}; j < NR; ++j) {
+          to[j] = 0;
+        }
+        to += NR;
+      }
+    }
+  }
+}
+
+// RES(1:m,1:n) += A(1:MR,1:kc) * B(1:kc,1:NR) from packed micro-panels.
+template <typename T>
+inline RT_API_ATTRS void GemmMicroKernel(SubscriptValue kc,
+    const typename GemmTraits<T>::Real *RESTRICT a,
+    const typename GemmTraits<T>::Real *RESTRICT b, T *RESTRICT c,
+    SubscriptValue ldc, SubscriptValue m, SubscriptValue n) {
+  using Real = typename GemmTraits<T>::Real;
+  constexpr SubscriptValue MR{GemmBlocking<T>::MR};
+  constexpr SubscriptValue NR{GemmBlocking<T>::NR};
+  if constexpr (GemmTraits<T>::isComplex) {
+    Real re[NR][MR]{}, im[NR][MR]{};
+    for (SubscriptValue p{0}; p < kc; ++p) {
+      Real ar[MR], ai[MR];
+      for (SubscriptValue i{0}; i < MR; ++i) {
+        ar[i] = a[i];
+        ai[i] = a[MR + i];
+      }
+      for (SubscriptValue j{0}; j < NR; ++j) {
+        Real br{b[j]}, bi{b[NR + j]};
+        for (SubscriptValue i{0}; i < MR; ++i) {
+          re[j][i] += ar[i] * br - ai[i] * bi;
+          im[j][i] += ar[i] * bi + ai[i] * br;
+        }
+      }
+      a += 2 * MR;
+      b += 2 * NR;
+    }
+    for (SubscriptValue j{0}; j < n; ++j) {
+      for (SubscriptValue i{0}; i < m; ++i) {
+        c[i + j * ldc] += T{re[j][i], im[j][i]};
+      }
+    }
+  } else {
+    Real acc[NR][MR]{};
+    for (SubscriptValue p{0}; p < kc; ++p) {
+      Real av[MR];
+      for (SubscriptValue i{0}; i < MR; ++i) {
+        av[i] = a[i];
+      }
+      for (SubscriptValue j{0}; j < NR; ++j) {
+        Real bj{b[j]};
+        for (SubscriptValue i{0}; i < MR; ++i) {
+          acc[j][i] += av[i] * bj;
+        }
+      }
+      a += MR;
+      b += NR;
+    }
+    for (SubscriptValue j{0}; j < n; ++j) {
+      for (SubscriptValue i{0}; i < m; ++i) {
+        c[i + j * ldc] += acc[j][i];
+      }
+    }
+  }
+}
+
+// RES = X * Y for RES(rows,cols) with unit row stride and column stride ldr,
+// X(rows,n) with element (i,k) at x[i*xRowStride + k*xColumnStride], and
+// Y(n,cols) with element (k,j) at y[k*yRowStride + j*yColumnStride].
+// All strides are in elements.
+template <typename T>
+RT_API_ATTRS void BlockedMatrixTimesMatrix(T *RESTRICT product,
+    SubscriptValue rows, SubscriptValue cols, SubscriptValue ldr,
+    const T *RESTRICT x, SubscriptValue xRowStride,
+    SubscriptValue xColumnStride, const T *RESTRICT y,
+    SubscriptValue yRowStride, SubscriptValue yColumnStride, SubscriptValue n,
+    const Terminator &terminator) {
+  using Real = typename GemmTraits<T>::Real;
+  using Blocking = GemmBlocking<T>;
+  constexpr SubscriptValue MR{Blocking::MR}, NR{Blocking::NR};
+  for (SubscriptValue j{0}; j < cols; ++j) {
+    std::fill_n(product + j * ldr, rows, T{});
+  }
+  if (rows <= 0 || cols <= 0 || n <= 0) {
+    return;
+  }
+  // Size the packing buffers for this problem rather than for full blocks.
+  SubscriptValue kcMax{std::min(Blocking::KC, n)};
+  SubscriptValue mcMax{std::min(Blocking::MC, (rows + MR - 1) / MR * MR)};
+  SubscriptValue ncMax{std::min(Blocking::NC, (cols + NR - 1) / NR * NR)};
+  OwningPtr<Real> packedX{reinterpret_cast<Real *>(
+      AllocateMemoryOrCrash(terminator, mcMax * kcMax * sizeof(T)))};
+  OwningPtr<Real> packedY{reinterpret_cast<Real *>(
+      AllocateMemoryOrCrash(terminator, kcMax * ncMax * sizeof(T)))};
+  constexpr int reals{GemmTraits<T>::isComplex ? 2 : 1};
+  for (SubscriptValue jc{0}; jc < cols; jc += Blocking::NC) {
+    SubscriptValue nc{std::min(Blocking::NC, cols - jc)};
+    for (SubscriptValue pc{0}; pc < n; pc += Blocking::KC) {
+      SubscriptValue kc{std::min(Blocking::KC, n - pc)};
+      PackGemmB(packedY.get(), y + pc * yRowStride + jc * yColumnStride, kc, nc,
+          yRowStride, yColumnStride);
+      for (SubscriptValue ic{0}; ic < rows; ic += Blocking::MC) {
+        SubscriptValue mc{std::min(Blocking::MC, rows - ic)};
+        PackGemmA(packedX.get(), x + ic * xRowStride + pc * xColumnStride, mc,
+            kc, xRowStride, xColumnStride);
+        for (SubscriptValue jr{0}; jr < nc; jr += NR) {
+          const Real *b{packedY.get() + jr * kc * reals};
+          for (SubscriptValue ir{0}; ir < mc; ir += MR) {
+            GemmMicroKernel<T>(kc, packedX.get() + ir * kc * reals, b,
+                product + (ic + ir) + (jc + jr) * ldr, ldr,
+                std::min(MR, mc - ir), std::min(NR, nc - jr));
+          }
+        }
+      }
+    }
+  }
+}
+
+// BlockedMatrixTimesMatrix() with the result split into column slices, or
+// for results with few columns into row slices as well, that are computed
+// in parallel.  Slices are aligned to the MR x NR register tiles.
+template <typename T>
+RT_API_ATTRS void ParallelBlockedMatrixTimesMatrix(T *RESTRICT product,
+    SubscriptValue rows, SubscriptValue cols, SubscriptValue ldr,
+    const T *RESTRICT x, SubscriptValue xRowStride,
+    SubscriptValue xColumnStride, const T *RESTRICT y,
+    SubscriptValue yRowStride, SubscriptValue yColumnStride, SubscriptValue n,
+    const Terminator &terminator) {
+  using Blocking = GemmBlocking<T>;
+  int threads{ParallelThreadsFor(static_cast<std::size_t>(rows) * cols * n,
+      parallelMatmulWorkPerThread)};
+  if (threads <= 1) {
+    BlockedMatrixTimesMatrix<T>(product, rows, cols, ldr, x, xRowStride,
+        xColumnStride, y, yRowStride, yColumnStride, n, terminator);
+    return;
+  }
+  WorkSplit colSplit{cols, threads, Blocking::NR};
+  WorkSplit rowSplit{rows,
+      std::max<std::int64_t>(threads / colSplit.chunks(), 1), Blocking::MR};
+  ParallelFor(rowSplit.chunks() * colSplit.chunks(), [&](std::size_t j) {
+    std::int64_t r{static_cast<std::int64_t>(j) % rowSplit.chunks()};
+    std::int64_t c{static_cast<std::int64_t>(j) / rowSplit.chunks()};
+    SubscriptValue i0{rowSplit.Begin(r)}, j0{colSplit.Begin(c)};
+    BlockedMatrixTimesMatrix<T>(product + i0 + j0 * ldr, rowSplit.Size(r),
+        colSplit.Size(c), ldr, x + i0 * xRowStride, xRowStride, xColumnStride,
+        y + j0 * yColumnStride, yRowStride, yColumnStride, n, terminator);
+  });
+}
+
+} // namespace Fortran::runtime
+#endif // FORTRAN_RUNTIME_MATMUL_GEMM_H_
@@ -17,12 +17,17 @@
 // of logical kinds (16).  A single template undergoes many instantiations
 // to cover all of the valid possibilities.
 //
-// The usefulness of this optimization should be reviewed once Matmul is swapped
-// to use the faster BLAS routines.
+// Contiguous REAL and COMPLEX products of matrices with the same type and
+// kind use the cache-blocked kernel in matmul-gemm.h, as MATMUL does.
+// The usefulness of this optimization should be reviewed for the remaining
+// cases once Matmul is swapped to use the faster BLAS routines.
 
 #include "flang/Runtime/matmul-transpose.h"
+#include "blas.h"
+#include "matmul-gemm.h"
 #include "terminator.h"
 #include "tools.h"
+#include "worker-pool.h"
 #include "flang/Common/optional.h"
 #include "flang/Runtime/c-or-cpp.h"
 #include "flang/Runtime/cpp-type.h"
@@ -94,7 +99,7 @@ inline static RT_API_ATTRS void MatrixTransposedTimesMatrix(
 RT_DIAG_POP
 
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT>
-inline static RT_API_ATTRS void MatrixTransposedTimesMatrixHelper(
+inline static RT_API_ATTRS void MatrixTransposedTimesMatrixSlice(
     CppTypeFor<RCAT, RKIND> *RESTRICT product, SubscriptValue rows,
     SubscriptValue cols, const XT *RESTRICT x, const YT *RESTRICT y,
     SubscriptValue n, Fortran::common::optional<std::size_t> xColumnByteStride,
@@ -118,6 +123,27 @@ inline static RT_API_ATTRS void MatrixTransposedTimesMatrixHelper(
   }
 }
 
+// Large products are split by result columns across the worker threads.
+template <TypeCategory RCAT, int RKIND, typename XT, typename YT>
+inline static RT_API_ATTRS void MatrixTransposedTimesMatrixHelper(
+    CppTypeFor<RCAT, RKIND> *RESTRICT product, SubscriptValue rows,
+    SubscriptValue cols, const XT *RESTRICT x, const YT *RESTRICT y,
+    SubscriptValue n, Fortran::common::optional<std::size_t> xColumnByteStride,
+    Fortran::common::optional<std::size_t> yColumnByteStride) {
+  WorkSplit split{cols,
+      ParallelThreadsFor(static_cast<std::size_t>(rows) * cols * n,
+          parallelMatmulWorkPerThread)};
+  ParallelFor(split.chunks(), [&](std::size_t c) {
+    SubscriptValue j0{split.Begin(c)};
+    const YT *yp{yColumnByteStride
+            ? reinterpret_cast<const YT *>(
+                  reinterpret_cast<const char *>(y) + j0 * *yColumnByteStride)
+            : y + j0 * n};
+    MatrixTransposedTimesMatrixSlice<RCAT, RKIND, XT, YT>(product + j0 * rows,
+        rows, split.Size(c), x, yp, n, xColumnByteStride, yColumnByteStride);
+  });
+}
+
 RT_DIAG_PUSH
 RT_DIAG_DISABLE_CALL_HOST_FROM_DEVICE_WARN
 
@@ -160,18 +186,29 @@ inline static RT_API_ATTRS void MatrixTransposedTimesVector(
 
 RT_DIAG_POP
 
+// Large products are split by result elements (columns of X) across the
+// worker threads.
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT>
 inline static RT_API_ATTRS void MatrixTransposedTimesVectorHelper(
     CppTypeFor<RCAT, RKIND> *RESTRICT product, SubscriptValue rows,
     SubscriptValue n, const XT *RESTRICT x, const YT *RESTRICT y,
     Fortran::common::optional<std::size_t> xColumnByteStride) {
-  if (!xColumnByteStride) {
-    MatrixTransposedTimesVector<RCAT, RKIND, XT, YT, false>(
-        product, rows, n, x, y);
-  } else {
-    MatrixTransposedTimesVector<RCAT, RKIND, XT, YT, true>(
-        product, rows, n, x, y, *xColumnByteStride);
-  }
+  WorkSplit split{rows,
+      ParallelThreadsFor(
+          static_cast<std::size_t>(rows) * n, parallelMatmulWorkPerThread)};
+  ParallelFor(split.chunks(), [&](std::size_t c) {
+    SubscriptValue i0{split.Begin(c)};
+    if (!xColumnByteStride) {
+      MatrixTransposedTimesVector<RCAT, RKIND, XT, YT, false>(
+          product + i0, split.Size(c), n, x + i0 * n, y);
+    } else {
+      MatrixTransposedTimesVector<RCAT, RKIND, XT, YT, true>(product + i0,
+          split.Size(c), n,
+          reinterpret_cast<const XT *>(
+              reinterpret_cast<const char *>(x) + i0 * *xColumnByteStride),
+          y, *xColumnByteStride);
+    }
+  });
 }
 
 RT_DIAG_PUSH
@@ -247,7 +284,30 @@ inline static RT_API_ATTRS void DoMatmulTranspose(
         yColumnByteStride = y.SubscriptsToByteOffset(yAt);
       }
       if (resRank == 2) { // M*M -> M
-        // TODO: use BLAS-3 GEMM for supported types.
+        if constexpr (std::is_same_v<XT, YT> &&
+            std::is_same_v<XT, WriteResult> && IsBlockedGemmType<XT>) {
+          // TRANSPOSE(X) is X with its strides swapped, so the blocked
+          // kernel applies as it does for MATMUL.
+          auto xColumnStride{GetColumnStride<XT>(xColumnByteStride, n)};
+          auto yColumnStride{GetColumnStride<YT>(yColumnByteStride, n)};
+          if (xColumnStride && yColumnStride &&
+              BlasMatrixTimesMatrix<XT>(
+                  result.template OffsetElement<WriteResult>(), rows, cols,
+                  x.OffsetElement<XT>(), *xColumnStride, true,
+                  y.OffsetElement<YT>(), *yColumnStride, n)) {
+            return;
+          }
+          if (xColumnStride && yColumnStride &&
+              static_cast<std::size_t>(rows) * cols * n >=
+                  blockedGemmMinimumWork) {
+            ParallelBlockedMatrixTimesMatrix<XT>(
+                result.template OffsetElement<WriteResult>(), rows, cols, rows,
+                x.OffsetElement<XT>(), *xColumnStride, 1,
+                y.OffsetElement<YT>(), 1, *yColumnStride, n, terminator);
+            return;
+          }
+        }
+        // TODO: use BLAS-3 GEMM for other supported types.
         MatrixTransposedTimesMatrixHelper<RCAT, RKIND, XT, YT>(
             result.template OffsetElement<WriteResult>(), rows, cols,
             x.OffsetElement<XT>(), y.OffsetElement<YT>(), n, xColumnByteStride,
@@ -255,7 +315,17 @@ inline static RT_API_ATTRS void DoMatmulTranspose(
         return;
       }
       if (xRank == 2) { // M*V -> V
-        // TODO: use BLAS-2 GEMM for supported types.
+        if constexpr (std::is_same_v<XT, YT> &&
+            std::is_same_v<XT, WriteResult> && IsBlasType<XT>) {
+          // S/DGEMV('T',x,y), when registered
+          if (auto ldx{GetColumnStride<XT>(xColumnByteStride, n)}; ldx &&
+              BlasMatrixTimesVector<XT>(
+                  result.template OffsetElement<WriteResult>(), rows, n,
+                  x.OffsetElement<XT>(), *ldx, true, y.OffsetElement<YT>())) {
+            return;
+          }
+        }
+        // TODO: use BLAS-2 GEMV for COMPLEX.
         MatrixTransposedTimesVectorHelper<RCAT, RKIND, XT, YT>(
             result.template OffsetElement<WriteResult>(), rows, n,
             x.OffsetElement<XT>(), y.OffsetElement<YT>(), xColumnByteStride);
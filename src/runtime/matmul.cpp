@@ -10,18 +10,24 @@
 //
 // There are two main entry points; one establishes a descriptor for the
 // result and allocates it, and the other expects a result descriptor that
-// points to existing storage.
+// points to existing storage.  The batched entry points apply MATMUL to
+// each matrix in a rank-3 stack of them.
 //
 // This implementation must handle all combinations of numeric types and
 // kinds (100 - 165 cases depending on the target), plus all combinations
 // of logical kinds (16).  A single template undergoes many instantiations
 // to cover all of the valid possibilities.
 //
-// Places where BLAS routines could be called are marked as TODO items.
+// Contiguous REAL and COMPLEX products of matrices with the same type and
+// kind use the cache-blocked kernel in matmul-gemm.h; the remaining places
+// where BLAS routines could be called are marked as TODO items.
 
 #include "flang/Runtime/matmul.h"
+#include "blas.h"
+#include "matmul-gemm.h"
 #include "terminator.h"
 #include "tools.h"
+#include "worker-pool.h"
 #include "flang/Common/optional.h"
 #include "flang/Runtime/c-or-cpp.h"
 #include "flang/Runtime/cpp-type.h"
@@ -115,7 +121,7 @@ inline RT_API_ATTRS void MatrixTimesMatrix(
 RT_DIAG_POP
 
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT>
-inline RT_API_ATTRS void MatrixTimesMatrixHelper(
+inline RT_API_ATTRS void MatrixTimesMatrixSlice(
     CppTypeFor<RCAT, RKIND> *RESTRICT product, SubscriptValue rows,
     SubscriptValue cols, const XT *RESTRICT x, const YT *RESTRICT y,
     SubscriptValue n, Fortran::common::optional<std::size_t> xColumnByteStride,
@@ -139,6 +145,27 @@ inline RT_API_ATTRS void MatrixTimesMatrixHelper(
   }
 }
 
+// Large products are split by result columns across the worker threads.
+template <TypeCategory RCAT, int RKIND, typename XT, typename YT>
+inline RT_API_ATTRS void MatrixTimesMatrixHelper(
+    CppTypeFor<RCAT, RKIND> *RESTRICT product, SubscriptValue rows,
+    SubscriptValue cols, const XT *RESTRICT x, const YT *RESTRICT y,
+    SubscriptValue n, Fortran::common::optional<std::size_t> xColumnByteStride,
+    Fortran::common::optional<std::size_t> yColumnByteStride) {
+  WorkSplit split{cols,
+      ParallelThreadsFor(static_cast<std::size_t>(rows) * cols * n,
+          parallelMatmulWorkPerThread)};
+  ParallelFor(split.chunks(), [&](std::size_t c) {
+    SubscriptValue j0{split.Begin(c)};
+    const YT *yp{yColumnByteStride
+            ? reinterpret_cast<const YT *>(
+                  reinterpret_cast<const char *>(y) + j0 * *yColumnByteStride)
+            : y + j0 * n};
+    MatrixTimesMatrixSlice<RCAT, RKIND, XT, YT>(product + j0 * rows, rows,
+        split.Size(c), x, yp, n, xColumnByteStride, yColumnByteStride);
+  });
+}
+
 RT_DIAG_PUSH
 RT_DIAG_DISABLE_CALL_HOST_FROM_DEVICE_WARN
 
@@ -181,17 +208,28 @@ inline RT_API_ATTRS void MatrixTimesVector(
 
 RT_DIAG_POP
 
+// Large products are split by result rows across the worker threads; a
+// slice of the rows of X is a matrix with strided columns.
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT>
 inline RT_API_ATTRS void MatrixTimesVectorHelper(
     CppTypeFor<RCAT, RKIND> *RESTRICT product, SubscriptValue rows,
     SubscriptValue n, const XT *RESTRICT x, const YT *RESTRICT y,
     Fortran::common::optional<std::size_t> xColumnByteStride) {
-  if (!xColumnByteStride) {
-    MatrixTimesVector<RCAT, RKIND, XT, YT, false>(product, rows, n, x, y);
-  } else {
-    MatrixTimesVector<RCAT, RKIND, XT, YT, true>(
-        product, rows, n, x, y, *xColumnByteStride);
+  WorkSplit split{rows,
+      ParallelThreadsFor(
+          static_cast<std::size_t>(rows) * n, parallelMatmulWorkPerThread)};
+  if (split.chunks() > 1 && !xColumnByteStride) {
+    xColumnByteStride = rows * sizeof(XT);
   }
+  ParallelFor(split.chunks(), [&](std::size_t c) {
+    SubscriptValue i0{split.Begin(c)};
+    if (!xColumnByteStride) {
+      MatrixTimesVector<RCAT, RKIND, XT, YT, false>(product, rows, n, x, y);
+    } else {
+      MatrixTimesVector<RCAT, RKIND, XT, YT, true>(product + i0,
+          split.Size(c), n, x + i0, y, *xColumnByteStride);
+    }
+  });
 }
 
 RT_DIAG_PUSH
@@ -237,18 +275,29 @@ inline RT_API_ATTRS void VectorTimesMatrix(
 
 RT_DIAG_POP
 
+// Large products are split by result elements across the worker threads.
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT,
     bool SPARSE_COLUMNS = false>
 inline RT_API_ATTRS void VectorTimesMatrixHelper(
     CppTypeFor<RCAT, RKIND> *RESTRICT product, SubscriptValue n,
     SubscriptValue cols, const XT *RESTRICT x, const YT *RESTRICT y,
     Fortran::common::optional<std::size_t> yColumnByteStride) {
-  if (!yColumnByteStride) {
-    VectorTimesMatrix<RCAT, RKIND, XT, YT, false>(product, n, cols, x, y);
-  } else {
-    VectorTimesMatrix<RCAT, RKIND, XT, YT, true>(
-        product, n, cols, x, y, *yColumnByteStride);
-  }
+  WorkSplit split{cols,
+      ParallelThreadsFor(
+          static_cast<std::size_t>(cols) * n, parallelMatmulWorkPerThread)};
+  ParallelFor(split.chunks(), [&](std::size_t c) {
+    SubscriptValue j0{split.Begin(c)};
+    if (!yColumnByteStride) {
+      VectorTimesMatrix<RCAT, RKIND, XT, YT, false>(
+          product + j0, n, split.Size(c), x, y + j0 * n);
+    } else {
+      VectorTimesMatrix<RCAT, RKIND, XT, YT, true>(product + j0, n,
+          split.Size(c), x,
+          reinterpret_cast<const YT *>(
+              reinterpret_cast<const char *>(y) + j0 * *yColumnByteStride),
+          *yColumnByteStride);
+    }
+  });
 }
 
 RT_DIAG_PUSH
@@ -338,16 +387,29 @@ static inline RT_API_ATTRS void DoMatmul(
       // This implies that the column stride is divisible
       // by the element size, which is usually true.
       if (resRank == 2) { // M*M -> M
-        if (std::is_same_v<XT, YT>) {
-          if constexpr (std::is_same_v<XT, float>) {
-            // TODO: call BLAS-3 SGEMM
-            // TODO: try using CUTLASS for device.
-          } else if constexpr (std::is_same_v<XT, double>) {
-            // TODO: call BLAS-3 DGEMM
-          } else if constexpr (std::is_same_v<XT, std::complex<float>>) {
-            // TODO: call BLAS-3 CGEMM
-          } else if constexpr (std::is_same_v<XT, std::complex<double>>) {
-            // TODO: call BLAS-3 ZGEMM
+        if constexpr (std::is_same_v<XT, YT> &&
+            std::is_same_v<XT, WriteResult> && IsBlockedGemmType<XT>) {
+          // S/D/C/ZGEMM: call a registered BLAS, or else use the packed,
+          // cache-blocked kernel when the column strides are whole elements
+          // and the product is big enough to amortize the packing.
+          // TODO: try using CUTLASS for device.
+          auto xColumnStride{GetColumnStride<XT>(xColumnByteStride, extent[0])};
+          auto yColumnStride{GetColumnStride<YT>(yColumnByteStride, n)};
+          if (xColumnStride && yColumnStride &&
+              BlasMatrixTimesMatrix<XT>(
+                  result.template OffsetElement<WriteResult>(), extent[0],
+                  extent[1], x.OffsetElement<XT>(), *xColumnStride, false,
+                  y.OffsetElement<YT>(), *yColumnStride, n)) {
+            return;
+          }
+          if (xColumnStride && yColumnStride &&
+              static_cast<std::size_t>(extent[0]) * extent[1] * n >=
+                  blockedGemmMinimumWork) {
+            ParallelBlockedMatrixTimesMatrix<XT>(
+                result.template OffsetElement<WriteResult>(), extent[0],
+                extent[1], extent[0], x.OffsetElement<XT>(), 1, *xColumnStride,
+                y.OffsetElement<YT>(), 1, *yColumnStride, n, terminator);
+            return;
           }
         }
         MatrixTimesMatrixHelper<RCAT, RKIND, XT, YT>(
@@ -356,11 +418,18 @@ static inline RT_API_ATTRS void DoMatmul(
             yColumnByteStride);
         return;
       } else if (xRank == 2) { // M*V -> V
-        if (std::is_same_v<XT, YT>) {
-          if constexpr (std::is_same_v<XT, float>) {
-            // TODO: call BLAS-2 SGEMV(x,y)
-          } else if constexpr (std::is_same_v<XT, double>) {
-            // TODO: call BLAS-2 DGEMV(x,y)
+        if constexpr (std::is_same_v<XT, YT> &&
+            std::is_same_v<XT, WriteResult>) {
+          if constexpr (IsBlasType<XT>) {
+            // S/DGEMV(x,y), when registered
+            if (auto ldx{GetColumnStride<XT>(xColumnByteStride, extent[0])};
+                ldx &&
+                BlasMatrixTimesVector<XT>(
+                    result.template OffsetElement<WriteResult>(), extent[0], n,
+                    x.OffsetElement<XT>(), *ldx, false,
+                    y.OffsetElement<YT>())) {
+              return;
+            }
           } else if constexpr (std::is_same_v<XT, std::complex<float>>) {
             // TODO: call BLAS-2 CGEMV(x,y)
           } else if constexpr (std::is_same_v<XT, std::complex<double>>) {
@@ -372,11 +441,17 @@ static inline RT_API_ATTRS void DoMatmul(
             x.OffsetElement<XT>(), y.OffsetElement<YT>(), xColumnByteStride);
         return;
       } else { // V*M -> V
-        if (std::is_same_v<XT, YT>) {
-          if constexpr (std::is_same_v<XT, float>) {
-            // TODO: call BLAS-2 SGEMV(y,x)
-          } else if constexpr (std::is_same_v<XT, double>) {
-            // TODO: call BLAS-2 DGEMV(y,x)
+        if constexpr (std::is_same_v<XT, YT> &&
+            std::is_same_v<XT, WriteResult>) {
+          if constexpr (IsBlasType<XT>) {
+            // S/DGEMV('T',y,x), when registered
+            if (auto ldy{GetColumnStride<YT>(yColumnByteStride, n)}; ldy &&
+                BlasMatrixTimesVector<XT>(
+                    result.template OffsetElement<WriteResult>(), extent[0], n,
+                    y.OffsetElement<YT>(), *ldy, true,
+                    x.OffsetElement<XT>())) {
+              return;
+            }
           } else if constexpr (std::is_same_v<XT, std::complex<float>>) {
             // TODO: call BLAS-2 CGEMV(y,x)
           } else if constexpr (std::is_same_v<XT, std::complex<double>>) {
@@ -466,6 +541,193 @@ struct MatmulHelper {
         static_cast<int>(XCAT), XKIND, static_cast<int>(YCAT), YKIND);
   }
 };
+
+// Fixed-size instances of MatrixTimesMatrix for the small square matrices
+// that are typical of batched products; with constant extents, the compiler
+// can unroll them completely.
+template <TypeCategory CAT, int KIND, int N>
+RT_API_ATTRS void SmallMatrixTimesMatrix(
+    CppTypeFor<CAT, KIND> *RESTRICT product,
+    const CppTypeFor<CAT, KIND> *RESTRICT x,
+    const CppTypeFor<CAT, KIND> *RESTRICT y) {
+  using T = CppTypeFor<CAT, KIND>;
+  MatrixTimesMatrix<CAT, KIND, T, T, false, false>(product, N, N, x, y, N);
+}
+
+template <TypeCategory CAT, int KIND>
+using SmallMatrixKernel = void (*)(CppTypeFor<CAT, KIND> *,
+    const CppTypeFor<CAT, KIND> *, const CppTypeFor<CAT, KIND> *);
+
+template <TypeCategory CAT, int KIND>
+RT_API_ATTRS SmallMatrixKernel<CAT, KIND> GetSmallMatrixKernel(
+    SubscriptValue rows, SubscriptValue cols, SubscriptValue n) {
+  if constexpr (IsBlockedGemmType<CppTypeFor<CAT, KIND>>) {
+    if (rows == n && cols == n) {
+      switch (n) {
+      case 2:
+        return &SmallMatrixTimesMatrix<CAT, KIND, 2>;
+      case 3:
+        return &SmallMatrixTimesMatrix<CAT, KIND, 3>;
+      case 4:
+        return &SmallMatrixTimesMatrix<CAT, KIND, 4>;
+      case 5:
+        return &SmallMatrixTimesMatrix<CAT, KIND, 5>;
+      case 6:
+        return &SmallMatrixTimesMatrix<CAT, KIND, 6>;
+      case 7:
+        return &SmallMatrixTimesMatrix<CAT, KIND, 7>;
+      case 8:
+        return &SmallMatrixTimesMatrix<CAT, KIND, 8>;
+      }
+    }
+  }
+  return nullptr;
+}
+
+RT_DIAG_PUSH
+RT_DIAG_DISABLE_CALL_HOST_FROM_DEVICE_WARN
+
+// Multiplies each pair of matrices in a batch, once the operands have been
+// checked; X, Y, and RESULT all have the numeric type CAT(KIND).
+template <TypeCategory CAT, int KIND> struct BatchedMatmulHelper {
+  RT_API_ATTRS void operator()(const Descriptor &result, const Descriptor &x,
+      const Descriptor &y, Terminator &terminator) const {
+    if constexpr (CAT == TypeCategory::Integer || CAT == TypeCategory::Real ||
+        CAT == TypeCategory::Complex) {
+      using T = CppTypeFor<CAT, KIND>;
+      SubscriptValue rows{x.GetDimension(0).Extent()};
+      SubscriptValue n{x.GetDimension(1).Extent()};
+      SubscriptValue cols{y.GetDimension(1).Extent()};
+      SubscriptValue batch{x.GetDimension(2).Extent()};
+      SubscriptValue xBatchStride{x.GetDimension(2).ByteStride()};
+      SubscriptValue yBatchStride{y.GetDimension(2).ByteStride()};
+      SubscriptValue resBatchStride{result.GetDimension(2).ByteStride()};
+      WorkSplit split{batch,
+          ParallelThreadsFor(static_cast<std::size_t>(batch) * rows * cols * n,
+              parallelMatmulWorkPerThread)};
+      if (x.IsContiguous(1) && y.IsContiguous(1) && result.IsContiguous(2)) {
+        Fortran::common::optional<std::size_t> xColumnByteStride;
+        if (!x.IsContiguous(2)) {
+          xColumnByteStride = x.GetDimension(1).ByteStride();
+        }
+        Fortran::common::optional<std::size_t> yColumnByteStride;
+        if (!y.IsContiguous(2)) {
+          yColumnByteStride = y.GetDimension(1).ByteStride();
+        }
+        SmallMatrixKernel<CAT, KIND> kernel{nullptr};
+        if (!xColumnByteStride && !yColumnByteStride) {
+          kernel = GetSmallMatrixKernel<CAT, KIND>(rows, cols, n);
+        }
+        ParallelFor(split.chunks(), [&](std::size_t c) {
+          for (SubscriptValue j{split.Begin(c)},
+               end{split.Begin(c) + split.Size(c)};
+               j < end; ++j) {
+            T *product{result.OffsetElement<T>(j * resBatchStride)};
+            const T *xp{x.OffsetElement<T>(j * xBatchStride)};
+            const T *yp{y.OffsetElement<T>(j * yBatchStride)};
+            if (kernel) {
+              kernel(product, xp, yp);
+            } else {
+              MatrixTimesMatrixSlice<CAT, KIND, T, T>(product, rows, cols, xp,
+                  yp, n, xColumnByteStride, yColumnByteStride);
+            }
+          }
+        });
+      } else {
+        // General strides
+        using AccumType = AccumulationType<CAT, KIND>;
+        SubscriptValue xs[3], ys[3], rs[2];
+        for (int k{0}; k < 3; ++k) {
+          xs[k] = x.GetDimension(k).ByteStride();
+          ys[k] = y.GetDimension(k).ByteStride();
+        }
+        rs[0] = result.GetDimension(0).ByteStride();
+        rs[1] = result.GetDimension(1).ByteStride();
+        ParallelFor(split.chunks(), [&](std::size_t c) {
+          for (SubscriptValue b{split.Begin(c)},
+               end{split.Begin(c) + split.Size(c)};
+               b < end; ++b) {
+            for (SubscriptValue j{0}; j < cols; ++j) {
+              for (SubscriptValue i{0}; i < rows; ++i) {
+                AccumType sum{};
+                for (SubscriptValue k{0}; k < n; ++k) {
+                  sum += static_cast<AccumType>(*x.OffsetElement<T>(
+                             i * xs[0] + k * xs[1] + b * xs[2])) *
+                      static_cast<AccumType>(*y.OffsetElement<T>(
+                          k * ys[0] + j * ys[1] + b * ys[2]));
+                }
+                *result.OffsetElement<T>(
+                    i * rs[0] + j * rs[1] + b * resBatchStride) =
+                    static_cast<T>(sum);
+              }
+            }
+          }
+        });
+      }
+    } else {
+      terminator.Crash("MATMUL_BATCHED: bad operand type %d(%d)",
+          static_cast<int>(CAT), KIND);
+    }
+  }
+};
+
+RT_DIAG_POP
+
+// Checks the operands of a batched MATMUL, establishes and allocates the
+// result when IS_ALLOCATING, and dispatches on the type once for the whole
+// batch.
+template <bool IS_ALLOCATING>
+static RT_API_ATTRS void DoBatchedMatmul(
+    std::conditional_t<IS_ALLOCATING, Descriptor, const Descriptor> &result,
+    const Descriptor &x, const Descriptor &y, const char *sourceFile,
+    int line) {
+  Terminator terminator{sourceFile, line};
+  if (x.rank() != 3 || y.rank() != 3) {
+    terminator.Crash(
+        "MATMUL_BATCHED: bad argument ranks (%d * %d)", x.rank(), y.rank());
+  }
+  auto xCatKind{x.type().GetCategoryAndKind()};
+  auto yCatKind{y.type().GetCategoryAndKind()};
+  RUNTIME_CHECK(terminator, xCatKind.has_value() && yCatKind.has_value());
+  if (*xCatKind != *yCatKind) {
+    terminator.Crash("MATMUL_BATCHED: operand types differ (%d(%d), %d(%d))",
+        static_cast<int>(xCatKind->first), xCatKind->second,
+        static_cast<int>(yCatKind->first), yCatKind->second);
+  }
+  SubscriptValue extent[3]{x.GetDimension(0).Extent(),
+      y.GetDimension(1).Extent(), x.GetDimension(2).Extent()};
+  SubscriptValue n{x.GetDimension(1).Extent()};
+  if (n != y.GetDimension(0).Extent() ||
+      extent[2] != y.GetDimension(2).Extent()) {
+    terminator.Crash("MATMUL_BATCHED: unacceptable operand shapes "
+                     "(%jdx%jdx%jd, %jdx%jdx%jd)",
+        static_cast<std::intmax_t>(extent[0]), static_cast<std::intmax_t>(n),
+        static_cast<std::intmax_t>(extent[2]),
+        static_cast<std::intmax_t>(y.GetDimension(0).Extent()),
+        static_cast<std::intmax_t>(extent[1]),
+        static_cast<std::intmax_t>(y.GetDimension(2).Extent()));
+  }
+  if constexpr (IS_ALLOCATING) {
+    result.Establish(xCatKind->first, xCatKind->second, nullptr, 3, extent,
+        CFI_attribute_allocatable);
+    for (int j{0}; j < 3; ++j) {
+      result.GetDimension(j).SetBounds(1, extent[j]);
+    }
+    if (int stat{result.Allocate()}) {
+      terminator.Crash(
+          "MATMUL_BATCHED: could not allocate memory for result; STAT=%d",
+          stat);
+    }
+  } else {
+    RUNTIME_CHECK(terminator, result.rank() == 3);
+    RUNTIME_CHECK(terminator, result.type() == x.type());
+    for (int j{0}; j < 3; ++j) {
+      RUNTIME_CHECK(terminator, result.GetDimension(j).Extent() == extent[j]);
+    }
+  }
+  ApplyType<BatchedMatmulHelper, void>(xCatKind->first, xCatKind->second,
+      terminator, result, x, y, terminator);
+}
 } // namespace
 
 namespace Fortran::runtime {
@@ -492,6 +754,16 @@ RT_EXT_API_GROUP_BEGIN
 
 #include "flang/Runtime/matmul-instances.inc"
 
+void RTDEF(MatmulBatched)(Descriptor &result, const Descriptor &x,
+    const Descriptor &y, const char *sourceFile, int line) {
+  DoBatchedMatmul<true>(result, x, y, sourceFile, line);
+}
+
+void RTDEF(MatmulBatchedDirect)(const Descriptor &result, const Descriptor &x,
+    const Descriptor &y, const char *sourceFile, int line) {
+  DoBatchedMatmul<false>(result, x, y, sourceFile, line);
+}
+
 RT_EXT_API_GROUP_END
 } // extern "C"
 } // namespace Fortran::runtime
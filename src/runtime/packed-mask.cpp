@@ -0,0 +1,109 @@
+//===-- runtime/packed-mask.cpp -------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "packed-mask.h"
+#include "terminator.h"
+#include "tools.h"
+#include "worker-pool.h"
+#include <algorithm>
+
+namespace Fortran::runtime {
+
+RT_OFFLOAD_API_GROUP_BEGIN
+
+// Masks of at least this many elements are packed in parallel, in chunks
+// that are whole numbers of words.
+static constexpr std::size_t parallelPackMinimumElements{std::size_t{1} << 20};
+static constexpr std::size_t parallelPackChunkElements{std::size_t{1} << 16};
+
+// Packs the elements [first, first + count) of a contiguous mask whose
+// elements are of type INT; `first` is a multiple of the word size.
+template <typename INT>
+static RT_API_ATTRS void PackContiguous(PackedMask::Word *words,
+    const INT *mask, std::size_t first, std::size_t count) {
+  constexpr std::size_t wordBits{PackedMask::wordBits};
+  words += first / wordBits;
+  mask += first;
+  for (; count >= wordBits; count -= wordBits, mask += wordBits) {
+    PackedMask::Word w{0};
+    for (std::size_t j{0}; j < wordBits; ++j) {
+      w |= PackedMask::Word{mask[j] != 0} << j;
+    }
+    *words++ = w;
+  }
+  if (count > 0) {
+    PackedMask::Word w{0};
+    for (std::size_t j{0}; j < count; ++j) {
+      w |= PackedMask::Word{mask[j] != 0} << j;
+    }
+    *words = w;
+  }
+}
+
+// Packs the elements [first, first + count) of any mask.
+static RT_API_ATTRS void PackElements(PackedMask::Word *words,
+    const Descriptor &mask, std::size_t first, std::size_t count) {
+  if (mask.IsContiguous()) {
+    switch (mask.ElementBytes()) {
+    case 1:
+      return PackContiguous(
+          words, mask.OffsetElement<std::uint8_t>(), first, count);
+    case 2:
+      return PackContiguous(
+          words, mask.OffsetElement<std::uint16_t>(), first, count);
+    case 4:
+      return PackContiguous(
+          words, mask.OffsetElement<std::uint32_t>(), first, count);
+    case 8:
+      return PackContiguous(
+          words, mask.OffsetElement<std::uint64_t>(), first, count);
+    }
+  }
+  constexpr std::size_t wordBits{PackedMask::wordBits};
+  SubscriptValue at[maxRank];
+  mask.SubscriptsForZeroBasedElementNumber(at, first);
+  words += first / wordBits;
+  while (count > 0) {
+    std::size_t n{std::min(count, wordBits)};
+    PackedMask::Word w{0};
+    for (std::size_t j{0}; j < n; ++j, mask.IncrementSubscripts(at)) {
+      w |= PackedMask::Word{IsLogicalElementTrue(mask, at)} << j;
+    }
+    *words++ = w;
+    count -= n;
+  }
+}
+
+RT_API_ATTRS PackedMask::PackedMask(
+    const Descriptor &mask, const Terminator &terminator)
+    : elements_{mask.Elements()},
+      words_{static_cast<Word *>(
+          AllocateMemoryOrCrash(terminator, words() * sizeof(Word)))} {
+  if (elements_ >= parallelPackMinimumElements) {
+    std::size_t chunks{(elements_ + parallelPackChunkElements - 1) /
+        parallelPackChunkElements};
+    ParallelFor(chunks, [&](std::size_t j) {
+      std::size_t first{j * parallelPackChunkElements};
+      PackElements(words_.get(), mask, first,
+          std::min(parallelPackChunkElements, elements_ - first));
+    });
+  } else {
+    PackElements(words_.get(), mask, 0, elements_);
+  }
+}
+
+RT_API_ATTRS std::size_t PackedMask::Count() const {
+  std::size_t trues{0};
+  for (std::size_t j{0}, n{words()}; j < n; ++j) {
+    trues += common::BitPopulationCount(word(j));
+  }
+  return trues;
+}
+
+RT_OFFLOAD_API_GROUP_END
+} // namespace Fortran::runtime
@@ -0,0 +1,102 @@
+//===-- runtime/packed-mask.h -----------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// A LOGICAL MASK= array of any kind, shape, and stride, converted once into
+// a bitmap with one bit per element in array element order.  Operations
+// that are driven by a mask (masked reductions, PACK, UNPACK) can then
+// test an element by its zero-based element number, skip 64 false elements
+// with a single comparison, and process runs of true elements as dense
+// ranges, instead of applying a second vector of subscripts to the mask for
+// each element.
+
+#ifndef FORTRAN_RUNTIME_PACKED_MASK_H_
+#define FORTRAN_RUNTIME_PACKED_MASK_H_
+
+#include "flang/Common/bit-population-count.h"
+#include "flang/Runtime/descriptor.h"
+#include "flang/Runtime/memory.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Fortran::runtime {
+
+class Terminator;
+
+class PackedMask {
+public:
+  using Word = std::uint64_t;
+  static constexpr std::size_t wordBits{64};
+
+  RT_API_ATTRS PackedMask(const Descriptor &mask, const Terminator &);
+  PackedMask(const PackedMask &) = delete;
+  PackedMask &operator=(const PackedMask &) = delete;
+
+  RT_API_ATTRS std::size_t elements() const { return elements_; }
+  RT_API_ATTRS std::size_t words() const {
+    return (elements_ + wordBits - 1) / wordBits;
+  }
+  // Bits past the last element of the last word are zero.
+  RT_API_ATTRS Word word(std::size_t j) const { return words_.get()[j]; }
+
+  RT_API_ATTRS bool Test(std::size_t n) const {
+    return (word(n / wordBits) >> (n % wordBits)) & 1;
+  }
+
+  // The number of true elements.
+  RT_API_ATTRS std::size_t Count() const;
+
+  // Calls f(n, length) for each maximal run [n, n + length) of true elements
+  // within the elements [first, first + count), in increasing order of n.
+  // Stops and returns false as soon as a call to f returns false.
+  template <typename F>
+  RT_API_ATTRS bool ForEachTrueRun(
+      std::size_t first, std::size_t count, const F &f) const {
+    std::size_t end{first + count};
+    std::size_t runStart{0}, runLength{0}; // pending run
+    for (std::size_t at{first}; at < end;) {
+      std::size_t base{at - at % wordBits};
+      Word w{word(at / wordBits) & (~Word{0} << (at - base))};
+      if (end - base < wordBits) {
+        w &= ~(~Word{0} << (end - base));
+      }
+      while (w != 0) {
+        int start{TrailingZeroBitCount(w)};
+        Word rest{~(w >> start)};
+        int length{rest == 0 ? static_cast<int>(wordBits) - start
+                             : TrailingZeroBitCount(rest)};
+        if (runLength > 0 && runStart + runLength == base + start) {
+          runLength += length; // continues a run from the previous word
+        } else {
+          if (runLength > 0 && !f(runStart, runLength)) {
+            return false;
+          }
+          runStart = base + start;
+          runLength = length;
+        }
+        if (start + length == static_cast<int>(wordBits)) {
+          break;
+        }
+        w &= ~Word{0} << (start + length);
+      }
+      at = base + wordBits;
+    }
+    return runLength == 0 || f(runStart, runLength);
+  }
+
+  // The bit number of the lowest set bit of a nonzero word.
+  static constexpr RT_API_ATTRS int TrailingZeroBitCount(Word w) {
+    return common::BitPopulationCount((w & (~w + 1)) - 1);
+  }
+
+private:
+  std::size_t elements_;
+  OwningPtr<Word> words_;
+};
+
+} // namespace Fortran::runtime
+#endif // FORTRAN_RUNTIME_PACKED_MASK_H_
@@ -25,11 +25,34 @@ public:
   RT_API_ATTRS void GetResult(A *p, int /*zeroBasedDim*/ = -1) const {
     *p = static_cast<A>(product_);
   }
+  template <typename A> RT_API_ATTRS bool Accumulate(A x) {
+    product_ *= x;
+    return product_ != 0;
+  }
   template <typename A>
   RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
-    product_ *= *array_.Element<A>(at);
+    return Accumulate(*array_.Element<A>(at));
+  }
+  template <typename A>
+  RT_API_ATTRS bool AccumulateContiguous(const A *x, SubscriptValue n) {
+    if constexpr (std::is_integral_v<INTERMEDIATE>) {
+      // A zero product stays zero, so there's no need to stop early.
+      product_ = FoldContiguous(product_, x, n, INTERMEDIATE{1},
+          [](INTERMEDIATE a, INTERMEDIATE b) { return a * b; });
+    } else {
+      // Stop at a zero product, as AccumulateAt() does, so that later
+      // infinities or NaNs don't change the result.
+      for (SubscriptValue j{0}; j < n && product_ != 0; ++j) {
+        product_ *= x[j];
+      }
+    }
     return product_ != 0;
   }
+  RT_API_ATTRS void Merge(const NonComplexProductAccumulator &that) {
+    if (product_ != 0) { // as if the reduction had been cut short
+      product_ *= that.product_;
+    }
+  }
 
 private:
   const Descriptor &array_;
@@ -52,11 +75,24 @@ public:
     *p = {static_cast<ResultPart>(product_.real()),
         static_cast<ResultPart>(product_.imag())};
   }
+  template <typename A> RT_API_ATTRS bool Accumulate(const A &z) {
+    product_ *= z;
+    return true;
+  }
   template <typename A>
   RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
-    product_ *= *array_.Element<A>(at);
+    return Accumulate(*array_.Element<A>(at));
+  }
+  template <typename A>
+  RT_API_ATTRS bool AccumulateContiguous(const A *x, SubscriptValue n) {
+    for (SubscriptValue j{0}; j < n; ++j) {
+      product_ *= x[j];
+    }
     return true;
   }
+  RT_API_ATTRS void Merge(const ComplexProductAccumulator &that) {
+    product_ *= that.product_;
+  }
 
 private:
   const Descriptor &array_;
@@ -16,26 +16,39 @@
 
 namespace Fortran::runtime {
 
+// With ORDERED=.FALSE., the operation may be assumed to be associative, so
+// a large total reduction is split into chunks whose partial results are
+// then combined with the operation (see ParallelReduceElements()).  The
+// partial results are combined in array element order, so the operation
+// need not be commutative.
 template <typename T, bool isByValue> class ReduceAccumulator {
 public:
   using Operation = std::conditional_t<isByValue, ValueReductionOperation<T>,
       ReferenceReductionOperation<T>>;
   RT_API_ATTRS ReduceAccumulator(const Descriptor &array, Operation operation,
-      const T *identity, Terminator &terminator)
+      const T *identity, Terminator &terminator, bool ordered)
       : array_{array}, operation_{operation}, identity_{identity},
-        terminator_{terminator} {}
+        terminator_{terminator}, ordered_{ordered} {}
   RT_API_ATTRS void Reinitialize() { result_.reset(); }
   template <typename A>
   RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
-    const auto *operand{array_.Element<A>(at)};
-    if (result_) {
-      if constexpr (isByValue) {
-        result_ = operation_(*result_, *operand);
-      } else {
-        result_ = operation_(&*result_, operand);
+    Combine(*array_.Element<A>(at));
+    return true;
+  }
+  template <typename A>
+  RT_API_ATTRS bool AccumulateContiguous(const A *x, SubscriptValue n) {
+    if (n > 0) {
+      // A local copy of the result need not be reloaded after each call.
+      SubscriptValue j{0};
+      T result{result_ ? *result_ : x[j++]};
+      for (; j < n; ++j) {
+        if constexpr (isByValue) {
+          result = operation_(result, x[j]);
+        } else {
+          result = operation_(&result, &x[j]);
+        }
       }
-    } else {
-      result_ = *operand;
+      result_ = result;
     }
     return true;
   }
@@ -49,38 +62,55 @@ public:
       terminator_.Crash("REDUCE() without IDENTITY= has no result");
     }
   }
+  RT_API_ATTRS bool MayMerge() const { return !ordered_; }
+  RT_API_ATTRS void Merge(const ReduceAccumulator &that) {
+    if (that.result_) {
+      Combine(*that.result_);
+    }
+  }
 
 private:
+  RT_API_ATTRS void Combine(const T &operand) {
+    if (result_) {
+      if constexpr (isByValue) {
+        result_ = operation_(*result_, operand);
+      } else {
+        result_ = operation_(&*result_, &operand);
+      }
+    } else {
+      result_ = operand;
+    }
+  }
+
   const Descriptor &array_;
   common::optional<T> result_;
   Operation operation_;
   const T *identity_{nullptr};
   Terminator &terminator_;
+  bool ordered_{true};
 };
 
 template <typename T, typename OP, bool hasLength>
 class BufferedReduceAccumulator {
 public:
   RT_API_ATTRS BufferedReduceAccumulator(const Descriptor &array, OP operation,
-      const T *identity, Terminator &terminator)
+      const T *identity, Terminator &terminator, bool ordered)
       : array_{array}, operation_{operation}, identity_{identity},
-        terminator_{terminator} {}
+        terminator_{terminator}, ordered_{ordered} {}
+  // A copy has temporaries of its own.
+  RT_API_ATTRS BufferedReduceAccumulator(const BufferedReduceAccumulator &that)
+      : array_{that.array_}, operation_{that.operation_},
+        identity_{that.identity_}, terminator_{that.terminator_},
+        ordered_{that.ordered_}, activeTemp_{that.activeTemp_} {
+    if (activeTemp_ >= 0) {
+      std::memcpy(
+          &*temp_[activeTemp_], &*that.temp_[activeTemp_], elementBytes_);
+    }
+  }
   RT_API_ATTRS void Reinitialize() { activeTemp_ = -1; }
   template <typename A>
   RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
-    const auto *operand{array_.Element<A>(at)};
-    if (activeTemp_ >= 0) {
-      if constexpr (hasLength) {
-        operation_(&*temp_[1 - activeTemp_], length_, &*temp_[activeTemp_],
-            operand, length_, length_);
-      } else {
-        operation_(&*temp_[1 - activeTemp_], &*temp_[activeTemp_], operand);
-      }
-      activeTemp_ = 1 - activeTemp_;
-    } else {
-      activeTemp_ = 0;
-      std::memcpy(&*temp_[activeTemp_], operand, elementBytes_);
-    }
+    Combine(static_cast<const T *>(array_.Element<A>(at)));
     return true;
   }
   template <typename A>
@@ -93,12 +123,34 @@ public:
       terminator_.Crash("REDUCE() without IDENTITY= has no result");
     }
   }
+  RT_API_ATTRS bool MayMerge() const { return !ordered_; }
+  RT_API_ATTRS void Merge(const BufferedReduceAccumulator &that) {
+    if (that.activeTemp_ >= 0) {
+      Combine(&*that.temp_[that.activeTemp_]);
+    }
+  }
 
 private:
+  RT_API_ATTRS void Combine(const T *operand) {
+    if (activeTemp_ >= 0) {
+      if constexpr (hasLength) {
+        operation_(&*temp_[1 - activeTemp_], length_, &*temp_[activeTemp_],
+            operand, length_, length_);
+      } else {
+        operation_(&*temp_[1 - activeTemp_], &*temp_[activeTemp_], operand);
+      }
+      activeTemp_ = 1 - activeTemp_;
+    } else {
+      activeTemp_ = 0;
+      std::memcpy(&*temp_[activeTemp_], operand, elementBytes_);
+    }
+  }
+
   const Descriptor &array_;
   OP operation_;
   const T *identity_{nullptr};
   Terminator &terminator_;
+  bool ordered_{true};
   std::size_t elementBytes_{array_.ElementBytes()};
   OwningPtr<T> temp_[2]{SizedNew<T>{terminator_}(elementBytes_),
       SizedNew<T>{terminator_}(elementBytes_)};
@@ -117,7 +169,7 @@ std::int8_t RTDEF(ReduceInteger1Ref)(const Descriptor &array,
   return GetTotalReduction<TypeCategory::Integer, 1>(array, source, line, dim,
       mask,
       ReduceAccumulator<std::int8_t, false>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 std::int8_t RTDEF(ReduceInteger1Value)(const Descriptor &array,
@@ -128,7 +180,7 @@ std::int8_t RTDEF(ReduceInteger1Value)(const Descriptor &array,
   return GetTotalReduction<TypeCategory::Integer, 1>(array, source, line, dim,
       mask,
       ReduceAccumulator<std::int8_t, true>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(ReduceInteger1DimRef)(Descriptor &result, const Descriptor &array,
@@ -137,7 +189,7 @@ void RTDEF(ReduceInteger1DimRef)(Descriptor &result, const Descriptor &array,
     bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::int8_t, false>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Integer, 1>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -147,7 +199,7 @@ void RTDEF(ReduceInteger1DimValue)(Descriptor &result, const Descriptor &array,
     bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::int8_t, true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Integer, 1>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -159,7 +211,7 @@ std::int16_t RTDEF(ReduceInteger2Ref)(const Descriptor &array,
   return GetTotalReduction<TypeCategory::Integer, 2>(array, source, line, dim,
       mask,
       ReduceAccumulator<std::int16_t, false>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 std::int16_t RTDEF(ReduceInteger2Value)(const Descriptor &array,
@@ -170,7 +222,7 @@ std::int16_t RTDEF(ReduceInteger2Value)(const Descriptor &array,
   return GetTotalReduction<TypeCategory::Integer, 2>(array, source, line, dim,
       mask,
       ReduceAccumulator<std::int16_t, true>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(ReduceInteger2DimRef)(Descriptor &result, const Descriptor &array,
@@ -179,7 +231,7 @@ void RTDEF(ReduceInteger2DimRef)(Descriptor &result, const Descriptor &array,
     bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::int16_t, false>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Integer, 2>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -189,7 +241,7 @@ void RTDEF(ReduceInteger2DimValue)(Descriptor &result, const Descriptor &array,
     bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::int16_t, true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Integer, 2>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -201,7 +253,7 @@ std::int32_t RTDEF(ReduceInteger4Ref)(const Descriptor &array,
   return GetTotalReduction<TypeCategory::Integer, 4>(array, source, line, dim,
       mask,
       ReduceAccumulator<std::int32_t, false>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 std::int32_t RTDEF(ReduceInteger4Value)(const Descriptor &array,
@@ -212,7 +264,7 @@ std::int32_t RTDEF(ReduceInteger4Value)(const Descriptor &array,
   return GetTotalReduction<TypeCategory::Integer, 4>(array, source, line, dim,
       mask,
       ReduceAccumulator<std::int32_t, true>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(ReduceInteger4DimRef)(Descriptor &result, const Descriptor &array,
@@ -221,7 +273,7 @@ void RTDEF(ReduceInteger4DimRef)(Descriptor &result, const Descriptor &array,
     bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::int32_t, false>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Integer, 4>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -231,7 +283,7 @@ void RTDEF(ReduceInteger4DimValue)(Descriptor &result, const Descriptor &array,
     bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::int32_t, true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Integer, 4>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -243,7 +295,7 @@ std::int64_t RTDEF(ReduceInteger8Ref)(const Descriptor &array,
   return GetTotalReduction<TypeCategory::Integer, 8>(array, source, line, dim,
       mask,
       ReduceAccumulator<std::int64_t, false>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 std::int64_t RTDEF(ReduceInteger8Value)(const Descriptor &array,
@@ -254,7 +306,7 @@ std::int64_t RTDEF(ReduceInteger8Value)(const Descriptor &array,
   return GetTotalReduction<TypeCategory::Integer, 8>(array, source, line, dim,
       mask,
       ReduceAccumulator<std::int64_t, true>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(ReduceInteger8DimRef)(Descriptor &result, const Descriptor &array,
@@ -263,7 +315,7 @@ void RTDEF(ReduceInteger8DimRef)(Descriptor &result, const Descriptor &array,
     bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::int64_t, false>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Integer, 8>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -273,7 +325,7 @@ void RTDEF(ReduceInteger8DimValue)(Descriptor &result, const Descriptor &array,
     bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::int64_t, true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Integer, 8>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -286,7 +338,7 @@ common::int128_t RTDEF(ReduceInteger16Ref)(const Descriptor &array,
   return GetTotalReduction<TypeCategory::Integer, 16>(array, source, line, dim,
       mask,
       ReduceAccumulator<common::int128_t, false>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 common::int128_t RTDEF(ReduceInteger16Value)(const Descriptor &array,
@@ -297,7 +349,7 @@ common::int128_t RTDEF(ReduceInteger16Value)(const Descriptor &array,
   return GetTotalReduction<TypeCategory::Integer, 16>(array, source, line, dim,
       mask,
       ReduceAccumulator<common::int128_t, true>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(ReduceInteger16DimRef)(Descriptor &result, const Descriptor &array,
@@ -306,7 +358,7 @@ void RTDEF(ReduceInteger16DimRef)(Descriptor &result, const Descriptor &array,
     bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<common::int128_t, false>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Integer, 16>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -316,7 +368,7 @@ void RTDEF(ReduceInteger16DimValue)(Descriptor &result, const Descriptor &array,
     bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<common::int128_t, true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Integer, 16>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -329,7 +381,8 @@ float RTDEF(ReduceReal4Ref)(const Descriptor &array,
   Terminator terminator{source, line};
   return GetTotalReduction<TypeCategory::Real, 4>(array, source, line, dim,
       mask,
-      ReduceAccumulator<float, false>{array, operation, identity, terminator},
+      ReduceAccumulator<float, false>{
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 float RTDEF(ReduceReal4Value)(const Descriptor &array,
@@ -338,7 +391,8 @@ float RTDEF(ReduceReal4Value)(const Descriptor &array,
   Terminator terminator{source, line};
   return GetTotalReduction<TypeCategory::Real, 4>(array, source, line, dim,
       mask,
-      ReduceAccumulator<float, true>{array, operation, identity, terminator},
+      ReduceAccumulator<float, true>{
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(ReduceReal4DimRef)(Descriptor &result, const Descriptor &array,
@@ -346,7 +400,7 @@ void RTDEF(ReduceReal4DimRef)(Descriptor &result, const Descriptor &array,
     int dim, const Descriptor *mask, const float *identity, bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<float, false>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Real, 4>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -355,7 +409,7 @@ void RTDEF(ReduceReal4DimValue)(Descriptor &result, const Descriptor &array,
     int dim, const Descriptor *mask, const float *identity, bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<float, true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Real, 4>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -365,7 +419,8 @@ double RTDEF(ReduceReal8Ref)(const Descriptor &array,
   Terminator terminator{source, line};
   return GetTotalReduction<TypeCategory::Real, 8>(array, source, line, dim,
       mask,
-      ReduceAccumulator<double, false>{array, operation, identity, terminator},
+      ReduceAccumulator<double, false>{
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 double RTDEF(ReduceReal8Value)(const Descriptor &array,
@@ -374,7 +429,8 @@ double RTDEF(ReduceReal8Value)(const Descriptor &array,
   Terminator terminator{source, line};
   return GetTotalReduction<TypeCategory::Real, 8>(array, source, line, dim,
       mask,
-      ReduceAccumulator<double, true>{array, operation, identity, terminator},
+      ReduceAccumulator<double, true>{
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(ReduceReal8DimRef)(Descriptor &result, const Descriptor &array,
@@ -382,7 +438,7 @@ void RTDEF(ReduceReal8DimRef)(Descriptor &result, const Descriptor &array,
     int dim, const Descriptor *mask, const double *identity, bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<double, false>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Real, 8>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -391,7 +447,7 @@ void RTDEF(ReduceReal8DimValue)(Descriptor &result, const Descriptor &array,
     int dim, const Descriptor *mask, const double *identity, bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<double, true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Real, 8>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -404,7 +460,7 @@ long double RTDEF(ReduceReal10Ref)(const Descriptor &array,
   return GetTotalReduction<TypeCategory::Real, 10>(array, source, line, dim,
       mask,
       ReduceAccumulator<long double, false>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 long double RTDEF(ReduceReal10Value)(const Descriptor &array,
@@ -415,7 +471,7 @@ long double RTDEF(ReduceReal10Value)(const Descriptor &array,
   return GetTotalReduction<TypeCategory::Real, 10>(array, source, line, dim,
       mask,
       ReduceAccumulator<long double, true>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(ReduceReal10DimRef)(Descriptor &result, const Descriptor &array,
@@ -424,7 +480,7 @@ void RTDEF(ReduceReal10DimRef)(Descriptor &result, const Descriptor &array,
     bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<long double, false>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Real, 10>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -434,7 +490,7 @@ void RTDEF(ReduceReal10DimValue)(Descriptor &result, const Descriptor &array,
     bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<long double, true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Real, 10>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -448,7 +504,7 @@ CppFloat128Type RTDEF(ReduceReal16Ref)(const Descriptor &array,
   return GetTotalReduction<TypeCategory::Real, 16>(array, source, line, dim,
       mask,
       ReduceAccumulator<CppFloat128Type, false>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 CppFloat128Type RTDEF(ReduceReal16Value)(const Descriptor &array,
@@ -459,7 +515,7 @@ CppFloat128Type RTDEF(ReduceReal16Value)(const Descriptor &array,
   return GetTotalReduction<TypeCategory::Real, 16>(array, source, line, dim,
       mask,
       ReduceAccumulator<CppFloat128Type, true>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(ReduceReal16DimRef)(Descriptor &result, const Descriptor &array,
@@ -468,7 +524,7 @@ void RTDEF(ReduceReal16DimRef)(Descriptor &result, const Descriptor &array,
     bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<CppFloat128Type, false>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Real, 16>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -478,7 +534,7 @@ void RTDEF(ReduceReal16DimValue)(Descriptor &result, const Descriptor &array,
     bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<CppFloat128Type, true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Real, 16>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -493,7 +549,7 @@ void RTDEF(CppReduceComplex4Ref)(std::complex<float> &result,
   result = GetTotalReduction<TypeCategory::Complex, 4>(array, source, line, dim,
       mask,
       ReduceAccumulator<std::complex<float>, false>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(CppReduceComplex4Value)(std::complex<float> &result,
@@ -505,7 +561,7 @@ void RTDEF(CppReduceComplex4Value)(std::complex<float> &result,
   result = GetTotalReduction<TypeCategory::Complex, 4>(array, source, line, dim,
       mask,
       ReduceAccumulator<std::complex<float>, true>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(CppReduceComplex4DimRef)(Descriptor &result, const Descriptor &array,
@@ -514,7 +570,7 @@ void RTDEF(CppReduceComplex4DimRef)(Descriptor &result, const Descriptor &array,
     const std::complex<float> *identity, bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::complex<float>, false>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Complex, 4>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -525,7 +581,7 @@ void RTDEF(CppReduceComplex4DimValue)(Descriptor &result,
     const std::complex<float> *identity, bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::complex<float>, true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Complex, 4>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -538,7 +594,7 @@ void RTDEF(CppReduceComplex8Ref)(std::complex<double> &result,
   result = GetTotalReduction<TypeCategory::Complex, 8>(array, source, line, dim,
       mask,
       ReduceAccumulator<std::complex<double>, false>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(CppReduceComplex8Value)(std::complex<double> &result,
@@ -550,7 +606,7 @@ void RTDEF(CppReduceComplex8Value)(std::complex<double> &result,
   result = GetTotalReduction<TypeCategory::Complex, 8>(array, source, line, dim,
       mask,
       ReduceAccumulator<std::complex<double>, true>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(CppReduceComplex8DimRef)(Descriptor &result, const Descriptor &array,
@@ -559,7 +615,7 @@ void RTDEF(CppReduceComplex8DimRef)(Descriptor &result, const Descriptor &array,
     const std::complex<double> *identity, bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::complex<double>, false>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Complex, 8>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -570,7 +626,7 @@ void RTDEF(CppReduceComplex8DimValue)(Descriptor &result,
     const std::complex<double> *identity, bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::complex<double>, true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Complex, 8>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -584,7 +640,7 @@ void RTDEF(CppReduceComplex10Ref)(std::complex<long double> &result,
   result = GetTotalReduction<TypeCategory::Complex, 10>(array, source, line,
       dim, mask,
       ReduceAccumulator<std::complex<long double>, false>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(CppReduceComplex10Value)(std::complex<long double> &result,
@@ -596,7 +652,7 @@ void RTDEF(CppReduceComplex10Value)(std::complex<long double> &result,
   result = GetTotalReduction<TypeCategory::Complex, 10>(array, source, line,
       dim, mask,
       ReduceAccumulator<std::complex<long double>, true>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(CppReduceComplex10DimRef)(Descriptor &result,
@@ -606,7 +662,7 @@ void RTDEF(CppReduceComplex10DimRef)(Descriptor &result,
     const std::complex<long double> *identity, bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::complex<long double>, false>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Complex, 10>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -617,7 +673,7 @@ void RTDEF(CppReduceComplex10DimValue)(Descriptor &result,
     const std::complex<long double> *identity, bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::complex<long double>, true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Complex, 10>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -632,7 +688,7 @@ void RTDEF(CppReduceComplex16Ref)(std::complex<CppFloat128Type> &result,
   result = GetTotalReduction<TypeCategory::Complex, 16>(array, source, line,
       dim, mask,
       ReduceAccumulator<std::complex<CppFloat128Type>, false>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(CppReduceComplex16Value)(std::complex<CppFloat128Type> &result,
@@ -644,7 +700,7 @@ void RTDEF(CppReduceComplex16Value)(std::complex<CppFloat128Type> &result,
   result = GetTotalReduction<TypeCategory::Complex, 16>(array, source, line,
       dim, mask,
       ReduceAccumulator<std::complex<CppFloat128Type>, true>{
-          array, operation, identity, terminator},
+          array, operation, identity, terminator, ordered},
       "REDUCE");
 }
 void RTDEF(CppReduceComplex16DimRef)(Descriptor &result,
@@ -654,7 +710,7 @@ void RTDEF(CppReduceComplex16DimRef)(Descriptor &result,
     const std::complex<CppFloat128Type> *identity, bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::complex<CppFloat128Type>, false>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Complex, 16>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -665,7 +721,7 @@ void RTDEF(CppReduceComplex16DimValue)(Descriptor &result,
     const std::complex<CppFloat128Type> *identity, bool ordered) {
   Terminator terminator{source, line};
   using Accumulator = ReduceAccumulator<std::complex<CppFloat128Type>, true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Complex, 16>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -790,7 +846,7 @@ void RTDEF(ReduceChar1)(char *result, const Descriptor &array,
   Terminator terminator{source, line};
   BufferedReduceAccumulator<char, ReductionCharOperation<char>,
       /*hasLength=*/true>
-      accumulator{array, operation, identity, terminator};
+      accumulator{array, operation, identity, terminator, ordered};
   DoTotalReduction<char>(array, dim, mask, accumulator, "REDUCE", terminator);
   accumulator.GetResult(result);
 }
@@ -800,7 +856,7 @@ void RTDEF(ReduceCharacter1Dim)(Descriptor &result, const Descriptor &array,
   Terminator terminator{source, line};
   using Accumulator = BufferedReduceAccumulator<char,
       ReductionCharOperation<char>, /*hasLength=*/true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Character, 1>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -810,7 +866,7 @@ void RTDEF(ReduceChar2)(char16_t *result, const Descriptor &array,
   Terminator terminator{source, line};
   BufferedReduceAccumulator<char16_t, ReductionCharOperation<char16_t>,
       /*hasLength=*/true>
-      accumulator{array, operation, identity, terminator};
+      accumulator{array, operation, identity, terminator, ordered};
   DoTotalReduction<char16_t>(
       array, dim, mask, accumulator, "REDUCE", terminator);
   accumulator.GetResult(result);
@@ -821,7 +877,7 @@ void RTDEF(ReduceCharacter2Dim)(Descriptor &result, const Descriptor &array,
   Terminator terminator{source, line};
   using Accumulator = BufferedReduceAccumulator<char16_t,
       ReductionCharOperation<char16_t>, /*hasLength=*/true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Character, 2>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -831,7 +887,7 @@ void RTDEF(ReduceChar4)(char32_t *result, const Descriptor &array,
   Terminator terminator{source, line};
   BufferedReduceAccumulator<char32_t, ReductionCharOperation<char32_t>,
       /*hasLength=*/true>
-      accumulator{array, operation, identity, terminator};
+      accumulator{array, operation, identity, terminator, ordered};
   DoTotalReduction<char32_t>(
       array, dim, mask, accumulator, "REDUCE", terminator);
   accumulator.GetResult(result);
@@ -842,7 +898,7 @@ void RTDEF(ReduceCharacter4Dim)(Descriptor &result, const Descriptor &array,
   Terminator terminator{source, line};
   using Accumulator = BufferedReduceAccumulator<char32_t,
       ReductionCharOperation<char32_t>, /*hasLength=*/true>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Character, 4>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -853,7 +909,7 @@ void RTDEF(ReduceDerivedType)(char *result, const Descriptor &array,
   Terminator terminator{source, line};
   BufferedReduceAccumulator<char, ReductionDerivedTypeOperation,
       /*hasLength=*/false>
-      accumulator{array, operation, identity, terminator};
+      accumulator{array, operation, identity, terminator, ordered};
   DoTotalReduction<char>(array, dim, mask, accumulator, "REDUCE", terminator);
   accumulator.GetResult(result);
 }
@@ -863,7 +919,7 @@ void RTDEF(ReduceDerivedTypeDim)(Descriptor &result, const Descriptor &array,
   Terminator terminator{source, line};
   using Accumulator = BufferedReduceAccumulator<char,
       ReductionDerivedTypeOperation, /*hasLength=*/false>;
-  Accumulator accumulator{array, operation, identity, terminator};
+  Accumulator accumulator{array, operation, identity, terminator, ordered};
   PartialReduction<Accumulator, TypeCategory::Derived, 0>(result, array,
       array.ElementBytes(), dim, mask, terminator, "REDUCE", accumulator);
 }
@@ -22,11 +22,17 @@
 #define FORTRAN_RUNTIME_REDUCTION_TEMPLATES_H_
 
 #include "numeric-templates.h"
+#include "packed-mask.h"
+#include "summation.h"
 #include "terminator.h"
 #include "tools.h"
+#include "worker-pool.h"
 #include "flang/Runtime/cpp-type.h"
 #include "flang/Runtime/descriptor.h"
+#include "flang/Runtime/memory.h"
 #include <algorithm>
+#include <new>
+#include <type_traits>
 
 namespace Fortran::runtime {
 
@@ -37,6 +43,275 @@ namespace Fortran::runtime {
 // AccumulateAt() member function that applies supplied subscripts to the
 // array and does something with a scalar element, and a GetResult()
 // member function that copies a final result into its destination.
+// Accumulators may also support an AccumulateContiguous() member function
+// template that takes a pointer to a run of contiguous elements and their
+// count, so that total reductions over contiguous data can run as tight
+// loops instead of applying subscripts to each element, and an Accumulate()
+// member function that takes an element's value, for the same purpose in
+// partial reductions.
+
+// Detects whether ACCUMULATOR supports AccumulateContiguous<A>().
+template <typename ACCUMULATOR, typename A, typename = void>
+struct HasAccumulateContiguous : std::false_type {};
+template <typename ACCUMULATOR, typename A>
+struct HasAccumulateContiguous<ACCUMULATOR, A,
+    std::void_t<decltype(std::declval<ACCUMULATOR &>()
+                             .template AccumulateContiguous<A>(
+                                 std::declval<const A *>(), SubscriptValue{}))>>
+    : std::true_type {};
+
+// Detects whether ACCUMULATOR supports Accumulate() on a value of type A.
+template <typename ACCUMULATOR, typename A, typename = void>
+struct HasAccumulate : std::false_type {};
+template <typename ACCUMULATOR, typename A>
+struct HasAccumulate<ACCUMULATOR, A,
+    std::void_t<decltype(std::declval<ACCUMULATOR &>().Accumulate(
+        std::declval<const A &>()))>> : std::true_type {};
+
+// Combines `value` with x[0:n] using an associative and commutative
+// operation (e.g., integer addition), of which `identity` is the identity
+// element, in independent lanes that the compiler can vectorize.
+template <typename INTERMEDIATE, typename A, typename OPERATION>
+inline RT_API_ATTRS INTERMEDIATE FoldContiguous(INTERMEDIATE value,
+    const A *x, SubscriptValue n, INTERMEDIATE identity,
+    OPERATION operation) {
+  constexpr int lanes{8};
+  INTERMEDIATE lane[lanes];
+  for (int l{0}; l < lanes; ++l) {
+    lane[l] = identity;
+  }
+  SubscriptValue j{0};
+  for (; j + lanes <= n; j += lanes) {
+    for (int l{0}; l < lanes; ++l) {
+      lane[l] = operation(lane[l], static_cast<INTERMEDIATE>(x[j + l]));
+    }
+  }
+  for (; j < n; ++j) {
+    value = operation(value, static_cast<INTERMEDIATE>(x[j]));
+  }
+  for (int l{0}; l < lanes; ++l) {
+    value = operation(value, lane[l]);
+  }
+  return value;
+}
+
+// Returns the length of the runs of contiguous elements into which an array
+// falls in array element order, and sets `dims` to the number of leading
+// dimensions that each run spans.
+inline RT_API_ATTRS SubscriptValue GetContiguousRun(
+    const Descriptor &x, int &dims) {
+  SubscriptValue run{1};
+  auto elementBytes{static_cast<SubscriptValue>(x.ElementBytes())};
+  for (dims = 0; dims < x.rank(); ++dims) {
+    const Dimension &dim{x.GetDimension(dims)};
+    if (dim.ByteStride() != run * elementBytes && dim.Extent() != 1) {
+      break;
+    }
+    run *= dim.Extent();
+  }
+  return run;
+}
+
+// Detects whether ACCUMULATOR supports Merge(const ACCUMULATOR &), which
+// combines into an accumulator the state of another one that has processed
+// elements that follow all of its own in array element order.
+template <typename ACCUMULATOR, typename = void>
+struct HasMerge : std::false_type {};
+template <typename ACCUMULATOR>
+struct HasMerge<ACCUMULATOR,
+    std::void_t<decltype(std::declval<ACCUMULATOR &>().Merge(
+        std::declval<const ACCUMULATOR &>()))>> : std::true_type {};
+
+// An accumulator with Merge() may also have a MayMerge() member function
+// that decides at run time whether a particular reduction may be split,
+// as REDUCE() does for ORDERED=.FALSE.
+template <typename ACCUMULATOR, typename = void>
+struct HasMayMerge : std::false_type {};
+template <typename ACCUMULATOR>
+struct HasMayMerge<ACCUMULATOR,
+    std::void_t<decltype(std::declval<const ACCUMULATOR &>().MayMerge())>>
+    : std::true_type {};
+
+template <typename ACCUMULATOR>
+inline RT_API_ATTRS bool MayMerge(const ACCUMULATOR &accumulator) {
+  if constexpr (HasMayMerge<ACCUMULATOR>::value) {
+    return accumulator.MayMerge();
+  } else {
+    return HasMerge<ACCUMULATOR>::value;
+  }
+}
+
+// Total reductions of at least this many elements are performed in chunks
+// of a fixed size whose partial results are merged in a fixed order, so
+// that they can be computed in parallel; because the chunks do not depend
+// on the number of threads, neither does the result.
+constexpr std::size_t parallelReductionMinimumElements{std::size_t{1} << 20};
+constexpr std::size_t parallelReductionChunkElements{std::size_t{1} << 16};
+
+// Accumulates `count` elements of `x` starting at zero-based element number
+// `first` in array element order.  Returns false if the reduction was cut
+// short.
+template <typename TYPE, typename ACCUMULATOR>
+inline RT_API_ATTRS bool ReduceUnmaskedElements(const Descriptor &x,
+    std::size_t first, std::size_t count, ACCUMULATOR &accumulator) {
+  SubscriptValue xAt[maxRank];
+  x.SubscriptsForZeroBasedElementNumber(xAt, first);
+  if constexpr (HasAccumulateContiguous<ACCUMULATOR, TYPE>::value) {
+    int dims;
+    if (SubscriptValue run{GetContiguousRun(x, dims)}; run > 1) {
+      // Reduce each run of contiguous elements (or the part of it that is
+      // in range) in turn, stepping the subscripts of the remaining
+      // dimensions between runs.
+      int rank{x.rank()};
+      auto offset{static_cast<SubscriptValue>(first % run)};
+      while (count > 0) {
+        auto n{std::min<std::size_t>(run - offset, count)};
+        if (!accumulator.template AccumulateContiguous<TYPE>(
+                x.Element<TYPE>(xAt), n)) {
+          return false;
+        }
+        count -= n;
+        offset = 0;
+        for (int j{0}; j < dims; ++j) {
+          xAt[j] = x.GetDimension(j).LowerBound();
+        }
+        for (int j{dims}; j < rank; ++j) {
+          const Dimension &dim{x.GetDimension(j)};
+          if (xAt[j]++ < dim.UpperBound()) {
+            break;
+          }
+          xAt[j] = dim.LowerBound();
+        }
+      }
+      return true;
+    }
+  }
+  for (; count--; x.IncrementSubscripts(xAt)) {
+    if (!accumulator.template AccumulateAt<TYPE>(xAt)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// As above, but only for those elements that are true in `mask`, which are
+// visited a run of consecutive true elements at a time.
+template <typename TYPE, typename ACCUMULATOR>
+inline RT_API_ATTRS bool ReduceMaskedElements(const Descriptor &x,
+    const PackedMask &mask, std::size_t first, std::size_t count,
+    ACCUMULATOR &accumulator) {
+  if constexpr (HasAccumulateContiguous<ACCUMULATOR, TYPE>::value) {
+    if (x.IsContiguous()) {
+      const TYPE *p{x.OffsetElement<TYPE>()};
+      return mask.ForEachTrueRun(
+          first, count, [&](std::size_t n, std::size_t length) {
+            if constexpr (HasAccumulate<ACCUMULATOR, TYPE>::value) {
+              if (length < PackedMask::wordBits / 4) {
+                for (; length-- > 0; ++n) {
+                  if (!accumulator.Accumulate(p[n])) {
+                    return false;
+                  }
+                }
+                return true;
+              }
+            }
+            return accumulator.template AccumulateContiguous<TYPE>(
+                p + n, length);
+          });
+    }
+  }
+  // Step the subscripts from one run to the next when it is nearby;
+  // otherwise recompute them.
+  SubscriptValue xAt[maxRank];
+  std::size_t at{first};
+  x.SubscriptsForZeroBasedElementNumber(xAt, at);
+  return mask.ForEachTrueRun(
+      first, count, [&](std::size_t n, std::size_t length) {
+        if (length >= PackedMask::wordBits) {
+          at = n + length;
+          x.SubscriptsForZeroBasedElementNumber(xAt, at);
+          return ReduceUnmaskedElements<TYPE>(x, n, length, accumulator);
+        }
+        if (n - at < PackedMask::wordBits / 4) {
+          for (; at < n; ++at) {
+            x.IncrementSubscripts(xAt);
+          }
+        } else {
+          at = n;
+          x.SubscriptsForZeroBasedElementNumber(xAt, at);
+        }
+        for (; length-- > 0; ++at, x.IncrementSubscripts(xAt)) {
+          if (!accumulator.template AccumulateAt<TYPE>(xAt)) {
+            return false;
+          }
+        }
+        return true;
+      });
+}
+
+// Accumulates `count` elements of `x` starting at zero-based element number
+// `first` in array element order, with those elements of `mask` (if not
+// null) that are true.  Returns false if the reduction was cut short.
+template <typename TYPE, typename ACCUMULATOR>
+inline RT_API_ATTRS bool ReduceElements(const Descriptor &x,
+    const PackedMask *mask, std::size_t first, std::size_t count,
+    ACCUMULATOR &accumulator) {
+  if (mask) {
+    return ReduceMaskedElements<TYPE>(x, *mask, first, count, accumulator);
+  } else {
+    return ReduceUnmaskedElements<TYPE>(x, first, count, accumulator);
+  }
+}
+
+// Splits a large total reduction into fixed-size chunks that are reduced
+// in parallel, each by its own copy of the (initial) accumulator, and then
+// merges the partial results pairwise in a fixed tree shape.  The first
+// chunk is reduced by `accumulator` itself, which ends up with the result.
+template <typename TYPE, typename ACCUMULATOR>
+inline RT_API_ATTRS void ParallelReduceElements(const Descriptor &x,
+    const PackedMask *mask, std::size_t elements, ACCUMULATOR &accumulator,
+    Terminator &terminator) {
+  std::size_t chunks{(elements + parallelReductionChunkElements - 1) /
+      parallelReductionChunkElements};
+  OwningPtr<ACCUMULATOR> others{static_cast<ACCUMULATOR *>(
+      AllocateMemoryOrCrash(terminator, (chunks - 1) * sizeof(ACCUMULATOR)))};
+  for (std::size_t j{1}; j < chunks; ++j) {
+    new (others.get() + j - 1) ACCUMULATOR{accumulator};
+  }
+  auto partial{[&](std::size_t j) -> ACCUMULATOR & {
+    return j == 0 ? accumulator : others.get()[j - 1];
+  }};
+  ParallelFor(chunks, [&](std::size_t j) {
+    std::size_t first{j * parallelReductionChunkElements};
+    ReduceElements<TYPE>(x, mask, first,
+        std::min(parallelReductionChunkElements, elements - first),
+        partial(j));
+  });
+  for (std::size_t width{1}; width < chunks; width *= 2) {
+    for (std::size_t j{0}; j + width < chunks; j += 2 * width) {
+      partial(j).Merge(partial(j + width));
+    }
+  }
+  if constexpr (!std::is_trivially_destructible_v<ACCUMULATOR>) {
+    for (std::size_t j{1}; j < chunks; ++j) {
+      others.get()[j - 1].~ACCUMULATOR();
+    }
+  }
+}
+
+template <typename TYPE, typename ACCUMULATOR>
+inline RT_API_ATTRS void ReduceElementsInParallelIfLarge(const Descriptor &x,
+    const PackedMask *mask, std::size_t elements, ACCUMULATOR &accumulator,
+    Terminator &terminator) {
+  if constexpr (HasMerge<ACCUMULATOR>::value) {
+    if (elements >= parallelReductionMinimumElements &&
+        MayMerge(accumulator)) {
+      ParallelReduceElements<TYPE>(x, mask, elements, accumulator, terminator);
+      return;
+    }
+  }
+  ReduceElements<TYPE>(x, mask, 0, elements, accumulator);
+}
 
 // Total reduction of the array argument to a scalar (or to a vector in the
 // cases of FINDLOC, MAXLOC, & MINLOC).  These are the cases without DIM= or
@@ -49,32 +324,24 @@ inline RT_API_ATTRS void DoTotalReduction(const Descriptor &x, int dim,
     terminator.Crash("%s: bad DIM=%d for ARRAY argument with rank %d",
         intrinsic, dim, x.rank());
   }
-  SubscriptValue xAt[maxRank];
-  x.GetLowerBounds(xAt);
   if (mask) {
     CheckConformability(x, *mask, terminator, intrinsic, "ARRAY", "MASK");
-    if (mask->rank() > 0) {
-      SubscriptValue maskAt[maxRank];
-      mask->GetLowerBounds(maskAt);
-      for (auto elements{x.Elements()}; elements--;
-           x.IncrementSubscripts(xAt), mask->IncrementSubscripts(maskAt)) {
-        if (IsLogicalElementTrue(*mask, maskAt)) {
-          if (!accumulator.template AccumulateAt<TYPE>(xAt)) {
-            break;
-          }
-        }
+    if (mask->rank() == 0) {
+      if (!IsLogicalScalarTrue(*mask)) {
+        // scalar MASK=.FALSE.: return identity value
+        return;
       }
-      return;
-    } else if (!IsLogicalScalarTrue(*mask)) {
-      // scalar MASK=.FALSE.: return identity value
-      return;
+      mask = nullptr;
     }
   }
-  // No MASK=, or scalar MASK=.TRUE.
-  for (auto elements{x.Elements()}; elements--; x.IncrementSubscripts(xAt)) {
-    if (!accumulator.template AccumulateAt<TYPE>(xAt)) {
-      break; // cut short, result is known
-    }
+  std::size_t elements{x.Elements()};
+  if (mask) {
+    PackedMask packed{*mask, terminator};
+    ReduceElementsInParallelIfLarge<TYPE>(
+        x, &packed, elements, accumulator, terminator);
+  } else {
+    ReduceElementsInParallelIfLarge<TYPE>(
+        x, nullptr, elements, accumulator, terminator);
   }
 }
 
@@ -132,10 +399,23 @@ inline RT_API_ATTRS void ReduceDimToScalar(const Descriptor &x,
   GetExpandedSubscripts(xAt, x, zeroBasedDim, subscripts);
   const auto &dim{x.GetDimension(zeroBasedDim)};
   SubscriptValue at{dim.LowerBound()};
-  for (auto n{dim.Extent()}; n-- > 0; ++at) {
-    xAt[zeroBasedDim] = at;
-    if (!accumulator.template AccumulateAt<TYPE>(xAt)) {
-      break;
+  bool contiguous{false};
+  if constexpr (HasAccumulateContiguous<ACCUMULATOR, TYPE>::value) {
+    if (dim.ByteStride() == static_cast<SubscriptValue>(sizeof(TYPE))) {
+      contiguous = true;
+      if (SubscriptValue n{dim.Extent()}; n > 0) {
+        xAt[zeroBasedDim] = at;
+        accumulator.template AccumulateContiguous<TYPE>(
+            x.Element<TYPE>(xAt), n);
+      }
+    }
+  }
+  if (!contiguous) {
+    for (auto n{dim.Extent()}; n-- > 0; ++at) {
+      xAt[zeroBasedDim] = at;
+      if (!accumulator.template AccumulateAt<TYPE>(xAt)) {
+        break;
+      }
     }
   }
 #ifdef _MSC_VER // work around MSVC spurious error
@@ -147,19 +427,26 @@ inline RT_API_ATTRS void ReduceDimToScalar(const Descriptor &x,
 
 template <typename TYPE, typename ACCUMULATOR>
 inline RT_API_ATTRS void ReduceDimMaskToScalar(const Descriptor &x,
-    int zeroBasedDim, SubscriptValue subscripts[], const Descriptor &mask,
+    int zeroBasedDim, SubscriptValue subscripts[], const PackedMask &mask,
     TYPE *result, ACCUMULATOR &accumulator) {
-  SubscriptValue xAt[maxRank], maskAt[maxRank];
+  SubscriptValue xAt[maxRank];
   GetExpandedSubscripts(xAt, x, zeroBasedDim, subscripts);
-  GetExpandedSubscripts(maskAt, mask, zeroBasedDim, subscripts);
+  // Find the element numbers of array(j,:,k) for the mask.
+  std::size_t maskAt{0}, maskStep{1}, coefficient{1};
+  for (int j{0}; j < x.rank(); ++j) {
+    const Dimension &dim{x.GetDimension(j)};
+    if (j == zeroBasedDim) {
+      maskStep = coefficient;
+    } else {
+      maskAt += static_cast<std::size_t>(xAt[j] - dim.LowerBound()) *
+          coefficient;
+    }
+    coefficient *= dim.Extent();
+  }
   const auto &xDim{x.GetDimension(zeroBasedDim)};
   SubscriptValue xPos{xDim.LowerBound()};
-  const auto &maskDim{mask.GetDimension(zeroBasedDim)};
-  SubscriptValue maskPos{maskDim.LowerBound()};
-  for (auto n{x.GetDimension(zeroBasedDim).Extent()}; n-- > 0;
-       ++xPos, ++maskPos) {
-    maskAt[zeroBasedDim] = maskPos;
-    if (IsLogicalElementTrue(mask, maskAt)) {
+  for (auto n{xDim.Extent()}; n-- > 0; ++xPos, maskAt += maskStep) {
+    if (mask.Test(maskAt)) {
       xAt[zeroBasedDim] = xPos;
       if (!accumulator.template AccumulateAt<TYPE>(xAt)) {
         break;
@@ -173,6 +460,139 @@ inline RT_API_ATTRS void ReduceDimMaskToScalar(const Descriptor &x,
 #endif
 }
 
+// Steps the subscripts of dimensions [from, to) of an array in array element
+// order, wrapping around to the lower bounds after the last element.
+inline RT_API_ATTRS void IncrementSubscriptsOfDims(const Descriptor &descriptor,
+    SubscriptValue at[], int from, int to) {
+  for (int j{from}; j < to; ++j) {
+    const Dimension &dim{descriptor.GetDimension(j)};
+    if (at[j]++ < dim.UpperBound()) {
+      return;
+    }
+    at[j] = dim.LowerBound();
+  }
+}
+
+// Number of results computed together by ReduceDimBySweeping().
+constexpr SubscriptValue sweptReductionResults{512};
+
+// For DIM>1, walking array(j,:,k) for one result element at a time strides
+// through memory.  Instead, this computes the results for a tile of adjacent
+// j together: for each position along DIM it visits array(j,:,k) for the
+// j's of the tile in storage order, feeding each element to that result's
+// own accumulator.  Each result still sees its elements in the same order.
+template <typename TYPE, typename ACCUMULATOR>
+inline RT_API_ATTRS void ReduceDimBySweeping(Descriptor &result,
+    const Descriptor &x, int zeroBasedDim, const PackedMask *mask,
+    Terminator &terminator, ACCUMULATOR &accumulator) {
+  int rank{x.rank()};
+  SubscriptValue inner{1};
+  for (int j{0}; j < zeroBasedDim; ++j) {
+    inner *= x.GetDimension(j).Extent();
+  }
+  if (inner == 0) {
+    return; // empty result
+  }
+  SubscriptValue extent{x.GetDimension(zeroBasedDim).Extent()};
+  SubscriptValue xLowerBound{x.GetDimension(zeroBasedDim).LowerBound()};
+  const Dimension &dim0{x.GetDimension(0)};
+  SubscriptValue lower0{dim0.LowerBound()}, upper0{dim0.UpperBound()};
+  SubscriptValue stride0{dim0.ByteStride()};
+  SubscriptValue tile{std::min(inner, sweptReductionResults)};
+  OwningPtr<ACCUMULATOR> accumulators{static_cast<ACCUMULATOR *>(
+      AllocateMemoryOrCrash(terminator, tile * sizeof(ACCUMULATOR)))};
+  OwningPtr<bool> live{static_cast<bool *>(
+      AllocateMemoryOrCrash(terminator, tile * sizeof(bool)))};
+  for (SubscriptValue j{0}; j < tile; ++j) {
+    new (accumulators.get() + j) ACCUMULATOR{accumulator};
+  }
+  SubscriptValue xStart[maxRank], resultAt[maxRank], xAt[maxRank];
+  x.GetLowerBounds(xStart);
+  result.GetLowerBounds(resultAt);
+  // The element number (for the mask) of array(j0,k,...) is
+  // outerStart + k*inner + j0, numbering j0 from zero.
+  std::size_t outerStart{0};
+  for (auto outer{result.Elements() / inner}; outer-- > 0;
+       outerStart += inner * extent) {
+    for (SubscriptValue done{0}; done < inner;) {
+      SubscriptValue n{std::min(tile, inner - done)};
+      for (SubscriptValue j{0}; j < n; ++j) {
+        accumulators.get()[j].Reinitialize();
+        live.get()[j] = true;
+      }
+      for (SubscriptValue k{0}; k < extent; ++k) {
+        std::copy(xStart, xStart + rank, xAt);
+        xAt[zeroBasedDim] = xLowerBound + k;
+        std::size_t maskAt{outerStart + k * inner + done};
+        // Visit the elements of the tile a run along dimension 1 at a time.
+        for (SubscriptValue j{0}; j < n;) {
+          SubscriptValue run{std::min(n - j, upper0 - xAt[0] + 1)};
+          SubscriptValue end{j + run};
+          if constexpr (HasAccumulate<ACCUMULATOR, TYPE>::value) {
+            const char *p{x.Element<char>(xAt)};
+            for (; j < end; ++j, p += stride0) {
+              if (live.get()[j] && (!mask || mask->Test(maskAt + j))) {
+                live.get()[j] = accumulators.get()[j].Accumulate(
+                    *reinterpret_cast<const TYPE *>(p));
+              }
+            }
+          } else {
+            SubscriptValue at0{xAt[0]};
+            for (; j < end; ++j, ++xAt[0]) {
+              if (live.get()[j] && (!mask || mask->Test(maskAt + j))) {
+                live.get()[j] =
+                    accumulators.get()[j].template AccumulateAt<TYPE>(xAt);
+              }
+            }
+            xAt[0] = at0;
+          }
+          if (xAt[0] + run > upper0) {
+            xAt[0] = lower0;
+            IncrementSubscriptsOfDims(x, xAt, 1, zeroBasedDim);
+          } else {
+            xAt[0] += run;
+          }
+        }
+      }
+      for (SubscriptValue j{0}; j < n; ++j) {
+#ifdef _MSC_VER // work around MSVC spurious error
+        accumulators.get()[j].GetResult(
+            result.Element<TYPE>(resultAt), zeroBasedDim);
+#else
+        accumulators.get()[j].template GetResult<TYPE>(
+            result.Element<TYPE>(resultAt), zeroBasedDim);
+#endif
+        result.IncrementSubscripts(resultAt);
+      }
+      // Move on to the next tile; extent > 0, so xAt has been stepped.
+      std::copy(xAt, xAt + zeroBasedDim, xStart);
+      done += n;
+    }
+    IncrementSubscriptsOfDims(x, xStart, zeroBasedDim + 1, rank);
+  }
+}
+
+// ReduceDimBySweeping() needs copies of the accumulator.
+template <typename ACCUMULATOR>
+constexpr bool CanReduceDimBySweeping{
+    std::is_copy_constructible_v<ACCUMULATOR> &&
+    std::is_trivially_destructible_v<ACCUMULATOR>};
+
+// Sweeping pays off when consecutive elements along DIM are far apart.
+constexpr SubscriptValue sweptReductionMinimumStride{256}; // bytes
+
+inline RT_API_ATTRS bool WorthReducingDimBySweeping(
+    const Descriptor &x, int zeroBasedDim) {
+  if (zeroBasedDim == 0 || x.GetDimension(0).Extent() < 2) {
+    return false;
+  }
+  const Dimension &dim{x.GetDimension(zeroBasedDim)};
+  SubscriptValue stride{dim.ByteStride()};
+  return dim.Extent() > 1 &&
+      (stride >= sweptReductionMinimumStride ||
+          stride <= -sweptReductionMinimumStride);
+}
+
 // Partial reductions with DIM=
 
 template <typename ACCUMULATOR, TypeCategory CAT, int KIND>
@@ -189,10 +609,18 @@ inline RT_API_ATTRS void PartialReduction(Descriptor &result,
   if (mask) {
     CheckConformability(x, *mask, terminator, intrinsic, "ARRAY", "MASK");
     if (mask->rank() > 0) {
+      PackedMask packed{*mask, terminator};
+      if constexpr (CanReduceDimBySweeping<ACCUMULATOR>) {
+        if (WorthReducingDimBySweeping(x, dim - 1)) {
+          ReduceDimBySweeping<CppType>(
+              result, x, dim - 1, &packed, terminator, accumulator);
+          return;
+        }
+      }
       for (auto n{result.Elements()}; n-- > 0; result.IncrementSubscripts(at)) {
         accumulator.Reinitialize();
         ReduceDimMaskToScalar<CppType, ACCUMULATOR>(
-            x, dim - 1, at, *mask, result.Element<CppType>(at), accumulator);
+            x, dim - 1, at, packed, result.Element<CppType>(at), accumulator);
       }
       return;
     } else if (!IsLogicalScalarTrue(*mask)) {
@@ -205,6 +633,13 @@ inline RT_API_ATTRS void PartialReduction(Descriptor &result,
     }
   }
   // No MASK= or scalar MASK=.TRUE.
+  if constexpr (CanReduceDimBySweeping<ACCUMULATOR>) {
+    if (WorthReducingDimBySweeping(x, dim - 1)) {
+      ReduceDimBySweeping<CppType>(
+          result, x, dim - 1, nullptr, terminator, accumulator);
+      return;
+    }
+  }
   for (auto n{result.Elements()}; n-- > 0; result.IncrementSubscripts(at)) {
     accumulator.Reinitialize();
     ReduceDimToScalar<CppType, ACCUMULATOR>(
@@ -288,6 +723,28 @@ inline RT_API_ATTRS void TypedPartialNumericReduction(Descriptor &result,
   }
 }
 
+// Stores the result of MAXLOC, MINLOC, or FINDLOC without DIM= when that is
+// the location of the element of `x` with zero-based element number `at`,
+// or all zeroes when `at` is not less than the number of elements.
+template <int KIND> struct ElementLocationHelper {
+  RT_API_ATTRS void operator()(
+      const Descriptor &result, const Descriptor &x, std::size_t at) const {
+    auto *p{result.OffsetElement<CppTypeFor<TypeCategory::Integer, KIND>>()};
+    int rank{x.rank()};
+    if (at < x.Elements()) {
+      SubscriptValue location[maxRank];
+      x.SubscriptsForZeroBasedElementNumber(location, at);
+      for (int j{0}; j < rank; ++j) {
+        p[j] = location[j] - x.GetDimension(j).LowerBound() + 1;
+      }
+    } else {
+      for (int j{0}; j < rank; ++j) {
+        p[j] = 0;
+      }
+    }
+  }
+};
+
 template <typename ACCUMULATOR> struct LocationResultHelper {
   template <int KIND> struct Functor {
     RT_API_ATTRS void operator()(
@@ -364,17 +821,65 @@ template <int KIND>
 using Norm2AccumType =
     CppTypeFor<TypeCategory::Real, std::clamp(KIND, 8, Norm2LargestLDKind)>;
 
-template <int KIND> class Norm2Accumulator {
+// The sum of squares in Norm2Accumulator, which is rescaled whenever m
+// changes.  Only with Summation::Kahan does it carry a compensation term.
+template <typename T, bool COMPENSATED> class Norm2Sum {
+public:
+  RT_API_ATTRS void Reset() { sum_ = 0; }
+  RT_API_ATTRS T Value() const { return sum_; }
+  RT_API_ATTRS void Set(T value) { sum_ = value; }
+  RT_API_ATTRS void Scale(T factor) { sum_ *= factor; }
+  RT_API_ATTRS void Add(T term) { sum_ += term; }
+
+private:
+  T sum_{0};
+};
+
+template <typename T> class Norm2Sum<T, true> {
+public:
+  RT_API_ATTRS void Reset() { sum_ = correction_ = 0; }
+  RT_API_ATTRS T Value() const { return sum_ - correction_; }
+  RT_API_ATTRS void Set(T value) {
+    sum_ = value;
+    correction_ = 0;
+  }
+  RT_API_ATTRS void Scale(T factor) {
+    sum_ *= factor;
+    correction_ *= factor;
+  }
+  RT_API_ATTRS void Add(T term) {
+    auto next{term - correction_};
+    auto oldSum{sum_};
+    sum_ += next;
+    correction_ = (sum_ - oldSum) - next; // algebraically zero
+  }
+
+private:
+  T sum_{0};
+  T correction_{0};
+};
+
+// NORM2 accumulates m**2 * (1 + sum((others(:)/m)**2)), where m is the
+// value with the largest magnitude, rescaling the sum whenever m changes.
+// With Summation::Kahan that sum is compensated; with Summation::Pairwise,
+// each contiguous run of elements is instead handled in two passes, first
+// finding its m and then adding the squares pairwise.  The summation method
+// is a template argument, chosen once by the entry point.
+template <int KIND, Summation SUMMATION> class Norm2Accumulator {
 public:
   using Type = CppTypeFor<TypeCategory::Real, KIND>;
   using AccumType = Norm2AccumType<KIND>;
   explicit RT_API_ATTRS Norm2Accumulator(const Descriptor &array)
       : array_{array} {}
-  RT_API_ATTRS void Reinitialize() { max_ = sum_ = 0; }
+  RT_API_ATTRS void Reinitialize() {
+    max_ = 0;
+    sum_.Reset();
+  }
   template <typename A>
   RT_API_ATTRS void GetResult(A *p, int /*zeroBasedDim*/ = -1) const {
     // m * sqrt(1 + sum((others(:)/m)**2))
-    *p = static_cast<Type>(max_ * SQRTTy<AccumType>::compute(1 + sum_));
+    *p = static_cast<Type>(
+        max_ * SQRTTy<AccumType>::compute(1 + sum_.Value()));
   }
   RT_API_ATTRS bool Accumulate(Type x) {
     auto absX{ABSTy<AccumType>::compute(static_cast<AccumType>(x))};
@@ -383,12 +888,12 @@ public:
     } else if (absX > max_) {
       auto t{max_ / absX}; // < 1.0
       auto tsq{t * t};
-      sum_ *= tsq; // scale sum to reflect change to the max
-      sum_ += tsq; // include a term for the previous max
+      sum_.Scale(tsq); // scale sum to reflect change to the max
+      sum_.Add(tsq); // include a term for the previous max
       max_ = absX;
     } else { // absX <= max_
       auto t{absX / max_};
-      sum_ += t * t;
+      sum_.Add(t * t);
     }
     return true;
   }
@@ -396,18 +901,112 @@ public:
   RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
     return Accumulate(*array_.Element<A>(at));
   }
+  template <typename A>
+  RT_API_ATTRS bool AccumulateContiguous(const A *x, SubscriptValue n) {
+    if constexpr (SUMMATION == Summation::Pairwise) {
+      AccumType m{MaxMagnitude(x, n)};
+      if (m > 0 && m - m == 0) { // finite, not zero
+        PairwiseSum<AccumType> squares;
+        squares.AddTerms(n, [x, m](SubscriptValue j) {
+          auto t{static_cast<AccumType>(x[j]) / m};
+          return t * t;
+        });
+        // The term for m itself is 1.
+        MergeScaled(m, squares.Result() - 1);
+        return true;
+      } // else zero, infinite, or NaN; take the general path
+    }
+    for (SubscriptValue j{0}; j < n; ++j) {
+      Accumulate(x[j]);
+    }
+    return true;
+  }
+  RT_API_ATTRS void Merge(const Norm2Accumulator &that) {
+    MergeScaled(that.max_, that.sum_.Value());
+  }
 
 private:
+  RT_API_ATTRS void MergeScaled(AccumType thatMax, AccumType thatSum) {
+    // Each represents m**2 * (1 + sum); rescale the one with the smaller m.
+    if (thatMax == 0) {
+      return;
+    } else if (max_ == 0) {
+      max_ = thatMax;
+      sum_.Set(thatSum);
+    } else if (thatMax > max_) {
+      auto t{max_ / thatMax};
+      sum_.Set(thatSum + t * t * (1 + sum_.Value()));
+      max_ = thatMax;
+    } else {
+      auto t{thatMax / max_};
+      sum_.Set(sum_.Value() + t * t * (1 + thatSum));
+    }
+  }
+  // The largest magnitude in a contiguous run, ignoring NaNs, with several
+  // lanes so that the loop vectorizes.
+  template <typename A>
+  static RT_API_ATTRS AccumType MaxMagnitude(const A *x, SubscriptValue n) {
+    constexpr int lanes{8};
+    AccumType lane[lanes]{};
+    SubscriptValue j{0};
+    for (; j + lanes <= n; j += lanes) {
+      for (int l{0}; l < lanes; ++l) {
+        auto absX{ABSTy<AccumType>::compute(static_cast<AccumType>(x[j + l]))};
+        lane[l] = absX > lane[l] ? absX : lane[l];
+      }
+    }
+    for (int l{0}; j < n; ++j, ++l) {
+      auto absX{ABSTy<AccumType>::compute(static_cast<AccumType>(x[j]))};
+      lane[l] = absX > lane[l] ? absX : lane[l];
+    }
+    for (int l{1}; l < lanes; ++l) {
+      lane[0] = lane[l] > lane[0] ? lane[l] : lane[0];
+    }
+    return lane[0];
+  }
+
   const Descriptor &array_;
   AccumType max_{0}; // value (m) with largest magnitude
-  AccumType sum_{0}; // sum((others(:)/m)**2)
+  // sum((others(:)/m)**2)
+  Norm2Sum<AccumType, SUMMATION == Summation::Kahan> sum_;
 };
 
+// Selects the summation method once for a whole NORM2 without DIM=.
+template <int KIND>
+inline RT_API_ATTRS CppTypeFor<TypeCategory::Real, KIND> TotalNorm2(
+    const Descriptor &x, const char *source, int line, int dim) {
+  switch (GetSummation(Summation::Naive)) {
+  case Summation::Kahan:
+    return GetTotalReduction<TypeCategory::Real, KIND>(x, source, line, dim,
+        nullptr, Norm2Accumulator<KIND, Summation::Kahan>{x}, "NORM2");
+  case Summation::Pairwise:
+    return GetTotalReduction<TypeCategory::Real, KIND>(x, source, line, dim,
+        nullptr, Norm2Accumulator<KIND, Summation::Pairwise>{x}, "NORM2");
+  default:
+    return GetTotalReduction<TypeCategory::Real, KIND>(x, source, line, dim,
+        nullptr, Norm2Accumulator<KIND, Summation::Naive>{x}, "NORM2");
+  }
+}
+
 template <int KIND> struct Norm2Helper {
   RT_API_ATTRS void operator()(Descriptor &result, const Descriptor &x, int dim,
       const Descriptor *mask, Terminator &terminator) const {
-    DoMaxMinNorm2<TypeCategory::Real, KIND, Norm2Accumulator<KIND>>(
-        result, x, dim, mask, "NORM2", terminator);
+    switch (GetSummation(Summation::Naive)) {
+    case Summation::Kahan:
+      DoMaxMinNorm2<TypeCategory::Real, KIND,
+          Norm2Accumulator<KIND, Summation::Kahan>>(
+          result, x, dim, mask, "NORM2", terminator);
+      break;
+    case Summation::Pairwise:
+      DoMaxMinNorm2<TypeCategory::Real, KIND,
+          Norm2Accumulator<KIND, Summation::Pairwise>>(
+          result, x, dim, mask, "NORM2", terminator);
+      break;
+    default:
+      DoMaxMinNorm2<TypeCategory::Real, KIND,
+          Norm2Accumulator<KIND, Summation::Naive>>(
+          result, x, dim, mask, "NORM2", terminator);
+    }
   }
 };
 
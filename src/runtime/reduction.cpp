@@ -31,11 +31,23 @@ public:
   RT_API_ATTRS void GetResult(A *p, int /*zeroBasedDim*/ = -1) const {
     *p = static_cast<A>(and_);
   }
+  template <typename A> RT_API_ATTRS bool Accumulate(A x) {
+    and_ &= x;
+    return true;
+  }
   template <typename A>
   RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
-    and_ &= *array_.Element<A>(at);
+    return Accumulate(*array_.Element<A>(at));
+  }
+  template <typename A>
+  RT_API_ATTRS bool AccumulateContiguous(const A *x, SubscriptValue n) {
+    and_ = FoldContiguous(and_, x, n, ~INTERMEDIATE{0},
+        [](INTERMEDIATE a, INTERMEDIATE b) { return a & b; });
     return true;
   }
+  RT_API_ATTRS void Merge(const IntegerAndAccumulator &that) {
+    and_ &= that.and_;
+  }
 
 private:
   const Descriptor &array_;
@@ -51,11 +63,23 @@ public:
   RT_API_ATTRS void GetResult(A *p, int /*zeroBasedDim*/ = -1) const {
     *p = static_cast<A>(or_);
   }
+  template <typename A> RT_API_ATTRS bool Accumulate(A x) {
+    or_ |= x;
+    return true;
+  }
   template <typename A>
   RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
-    or_ |= *array_.Element<A>(at);
+    return Accumulate(*array_.Element<A>(at));
+  }
+  template <typename A>
+  RT_API_ATTRS bool AccumulateContiguous(const A *x, SubscriptValue n) {
+    or_ = FoldContiguous(or_, x, n, INTERMEDIATE{0},
+        [](INTERMEDIATE a, INTERMEDIATE b) { return a | b; });
     return true;
   }
+  RT_API_ATTRS void Merge(const IntegerOrAccumulator &that) {
+    or_ |= that.or_;
+  }
 
 private:
   const Descriptor &array_;
@@ -71,11 +95,23 @@ public:
   RT_API_ATTRS void GetResult(A *p, int /*zeroBasedDim*/ = -1) const {
     *p = static_cast<A>(xor_);
   }
+  template <typename A> RT_API_ATTRS bool Accumulate(A x) {
+    xor_ ^= x;
+    return true;
+  }
   template <typename A>
   RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
-    xor_ ^= *array_.Element<A>(at);
+    return Accumulate(*array_.Element<A>(at));
+  }
+  template <typename A>
+  RT_API_ATTRS bool AccumulateContiguous(const A *x, SubscriptValue n) {
+    xor_ = FoldContiguous(xor_, x, n, INTERMEDIATE{0},
+        [](INTERMEDIATE a, INTERMEDIATE b) { return a ^ b; });
     return true;
   }
+  RT_API_ATTRS void Merge(const IntegerXorAccumulator &that) {
+    xor_ ^= that.xor_;
+  }
 
 private:
   const Descriptor &array_;
@@ -204,6 +240,49 @@ void RTDEF(IParityDim)(Descriptor &result, const Descriptor &x, int dim,
 
 // ALL, ANY, COUNT, & PARITY
 
+// Runs of contiguous LOGICAL elements are examined as integers of the same
+// size, which are nonzero if and only if the elements are true, a block at
+// a time in loops that the compiler can vectorize.
+constexpr SubscriptValue logicalBlockElements{128};
+
+// Counts the nonzero elements of x[0:n].  Each block is counted in an
+// integer as wide as the elements, so that many are counted at once.
+template <typename INT>
+inline SubscriptValue CountNonzero(const INT *x, SubscriptValue n) {
+  using Counter = std::make_unsigned_t<INT>;
+  SubscriptValue count{0};
+  for (SubscriptValue j{0}; j < n; j += logicalBlockElements) {
+    SubscriptValue end{std::min(n, j + logicalBlockElements)};
+    Counter blockCount{0};
+    for (SubscriptValue k{j}; k < end; ++k) {
+      blockCount += x[k] != 0;
+    }
+    count += blockCount;
+  }
+  return count;
+}
+
+// Returns true if some element of x[0:n] is nonzero (NONZERO) or zero (not
+// NONZERO), stopping at the end of the first block that has one.  The
+// blocks start small so that an answer near the start is found quickly.
+template <bool NONZERO, typename INT>
+inline bool ContainsNonzero(const INT *x, SubscriptValue n) {
+  using Flags = std::make_unsigned_t<INT>;
+  SubscriptValue block{logicalBlockElements / 8};
+  for (SubscriptValue j{0}; j < n;
+       j += block, block = std::min(2 * block, logicalBlockElements)) {
+    SubscriptValue end{std::min(n, j + block)};
+    Flags hits{0};
+    for (SubscriptValue k{j}; k < end; ++k) {
+      hits |= (x[k] != 0) == NONZERO;
+    }
+    if (hits) {
+      return true;
+    }
+  }
+  return false;
+}
+
 enum class LogicalReduction { All, Any, Parity };
 
 template <LogicalReduction REDUCTION> class LogicalAccumulator {
@@ -225,12 +304,54 @@ public:
   bool AccumulateAt(const SubscriptValue at[]) {
     return Accumulate(IsLogicalElementTrue(array_, at));
   }
+  template <typename INT>
+  bool AccumulateContiguous(const INT *x, SubscriptValue n) {
+    if constexpr (REDUCTION == LogicalReduction::Parity) {
+      result_ = result_ != (CountNonzero(x, n) % 2 != 0);
+    } else {
+      // ALL is decided by a false element, ANY by a true one.
+      constexpr bool decisive{REDUCTION == LogicalReduction::Any};
+      if (ContainsNonzero<decisive>(x, n)) {
+        result_ = decisive;
+        return false;
+      }
+    }
+    return true;
+  }
 
 private:
   const Descriptor &array_;
   bool result_{REDUCTION == LogicalReduction::All};
 };
 
+// Applies the accumulator to n contiguous LOGICAL elements of x starting
+// at p.  Returns false if the reduction was cut short.
+template <typename ACCUMULATOR>
+inline bool AccumulateLogicalRun(ACCUMULATOR &accumulator, const Descriptor &x,
+    const char *p, SubscriptValue n) {
+  switch (x.ElementBytes()) {
+  case 1:
+    return accumulator.AccumulateContiguous(
+        reinterpret_cast<const std::uint8_t *>(p), n);
+  case 2:
+    return accumulator.AccumulateContiguous(
+        reinterpret_cast<const std::uint16_t *>(p), n);
+  case 4:
+    return accumulator.AccumulateContiguous(
+        reinterpret_cast<const std::uint32_t *>(p), n);
+  case 8:
+    return accumulator.AccumulateContiguous(
+        reinterpret_cast<const std::uint64_t *>(p), n);
+  default:
+    for (std::size_t bytes{x.ElementBytes()}; n-- > 0; p += bytes) {
+      if (!accumulator.Accumulate(IsLogicalValueTrue(p, bytes))) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
 template <typename ACCUMULATOR>
 inline auto GetTotalLogicalReduction(const Descriptor &x, const char *source,
     int line, int dim, ACCUMULATOR &&accumulator, const char *intrinsic) ->
@@ -241,7 +362,19 @@ inline auto GetTotalLogicalReduction(const Descriptor &x, const char *source,
   }
   SubscriptValue xAt[maxRank];
   x.GetLowerBounds(xAt);
-  for (auto elements{x.Elements()}; elements--; x.IncrementSubscripts(xAt)) {
+  auto elements{x.Elements()};
+  int dims;
+  if (SubscriptValue run{GetContiguousRun(x, dims)}; run > 1) {
+    // Reduce each run of contiguous elements in turn.
+    for (; elements > 0; elements -= run) {
+      if (!AccumulateLogicalRun(accumulator, x, x.Element<char>(xAt), run)) {
+        break; // cut short, result is known
+      }
+      IncrementSubscriptsOfDims(x, xAt, dims, x.rank());
+    }
+    return accumulator.Result();
+  }
+  for (; elements--; x.IncrementSubscripts(xAt)) {
     if (!accumulator.AccumulateAt(xAt)) {
       break; // cut short, result is known
     }
@@ -256,6 +389,11 @@ inline auto ReduceLogicalDimToScalar(const Descriptor &x, int zeroBasedDim,
   SubscriptValue xAt[maxRank];
   GetExpandedSubscripts(xAt, x, zeroBasedDim, subscripts);
   const auto &dim{x.GetDimension(zeroBasedDim)};
+  if (dim.ByteStride() == static_cast<SubscriptValue>(x.ElementBytes())) {
+    // array(:,k) is contiguous
+    AccumulateLogicalRun(accumulator, x, x.Element<char>(xAt), dim.Extent());
+    return accumulator.Result();
+  }
   SubscriptValue at{dim.LowerBound()};
   for (auto n{dim.Extent()}; n-- > 0; ++at) {
     xAt[zeroBasedDim] = at;
@@ -266,6 +404,78 @@ inline auto ReduceLogicalDimToScalar(const Descriptor &x, int zeroBasedDim,
   return accumulator.Result();
 }
 
+// For DIM>1, when the dimensions before DIM are contiguous, counts the true
+// elements of array(j,:,k) for a tile of adjacent j together by adding up
+// whole runs array(:,i,k) in storage order, instead of striding along DIM
+// for each result.  Calls store(n, count) for each result element number n.
+template <typename INT, typename STORE>
+inline void CountDimBySweeping(
+    const Descriptor &x, int zeroBasedDim, const STORE &store) {
+  constexpr SubscriptValue tile{512};
+  SubscriptValue inner{1};
+  for (int j{0}; j < zeroBasedDim; ++j) {
+    inner *= x.GetDimension(j).Extent();
+  }
+  std::size_t outer{1};
+  for (int j{zeroBasedDim + 1}; j < x.rank(); ++j) {
+    outer *= x.GetDimension(j).Extent();
+  }
+  const Dimension &dim{x.GetDimension(zeroBasedDim)};
+  SubscriptValue extent{dim.Extent()}, stride{dim.ByteStride()};
+  SubscriptValue at[maxRank];
+  x.GetLowerBounds(at);
+  std::size_t n{0};
+  for (; outer-- > 0;
+       IncrementSubscriptsOfDims(x, at, zeroBasedDim + 1, x.rank())) {
+    const char *start{x.Element<char>(at)};
+    for (SubscriptValue j{0}; j < inner; j += tile) {
+      SubscriptValue count[tile];
+      SubscriptValue width{std::min(tile, inner - j)};
+      std::fill_n(count, width, 0);
+      for (SubscriptValue i{0}; i < extent; ++i) {
+        const INT *run{reinterpret_cast<const INT *>(start + i * stride) + j};
+        for (SubscriptValue m{0}; m < width; ++m) {
+          count[m] += run[m] != 0;
+        }
+      }
+      for (SubscriptValue m{0}; m < width; ++m) {
+        store(n++, count[m]);
+      }
+    }
+  }
+}
+
+// Applies CountDimBySweeping() when it can be and is worthwhile; returns
+// false otherwise.
+template <typename STORE>
+inline bool CountDimBySweepingIfContiguous(
+    const Descriptor &x, int zeroBasedDim, const STORE &store) {
+  if (zeroBasedDim == 0 || x.GetDimension(0).Extent() < 2) {
+    return false;
+  }
+  int dims;
+  GetContiguousRun(x, dims);
+  if (dims < zeroBasedDim) {
+    return false;
+  }
+  switch (x.ElementBytes()) {
+  case 1:
+    CountDimBySweeping<std::uint8_t>(x, zeroBasedDim, store);
+    return true;
+  case 2:
+    CountDimBySweeping<std::uint16_t>(x, zeroBasedDim, store);
+    return true;
+  case 4:
+    CountDimBySweeping<std::uint32_t>(x, zeroBasedDim, store);
+    return true;
+  case 8:
+    CountDimBySweeping<std::uint64_t>(x, zeroBasedDim, store);
+    return true;
+  default:
+    return false;
+  }
+}
+
 template <LogicalReduction REDUCTION> struct LogicalReduceHelper {
   template <int KIND> struct Functor {
     void operator()(Descriptor &result, const Descriptor &x, int dim,
@@ -277,6 +487,17 @@ template <LogicalReduction REDUCTION> struct LogicalReduceHelper {
       result.GetLowerBounds(at);
       INTERNAL_CHECK(result.rank() == 0 || at[0] == 1);
       using CppType = CppTypeFor<TypeCategory::Logical, KIND>;
+      if constexpr (REDUCTION == LogicalReduction::Parity) {
+        // PARITY has to see every element; ALL and ANY can usually stop
+        // early along each row, so they are not swept.
+        CppType *p{result.OffsetElement<CppType>()};
+        if (CountDimBySweepingIfContiguous(x, dim - 1,
+                [p](std::size_t n, SubscriptValue count) {
+                  p[n] = count % 2 != 0;
+                })) {
+          return;
+        }
+      }
       for (auto n{result.Elements()}; n-- > 0; result.IncrementSubscripts(at)) {
         *result.Element<CppType>(at) =
             ReduceLogicalDimToScalar<LogicalAccumulator<REDUCTION>>(
@@ -303,13 +524,21 @@ public:
   explicit CountAccumulator(const Descriptor &array) : array_{array} {}
   void Reinitialize() { result_ = 0; }
   Type Result() const { return result_; }
-  template <typename IGNORED = void>
-  bool AccumulateAt(const SubscriptValue at[]) {
-    if (IsLogicalElementTrue(array_, at)) {
+  bool Accumulate(bool x) {
+    if (x) {
       ++result_;
     }
     return true;
   }
+  template <typename IGNORED = void>
+  bool AccumulateAt(const SubscriptValue at[]) {
+    return Accumulate(IsLogicalElementTrue(array_, at));
+  }
+  template <typename INT>
+  bool AccumulateContiguous(const INT *x, SubscriptValue n) {
+    result_ += CountNonzero(x, n);
+    return true;
+  }
 
 private:
   const Descriptor &array_;
@@ -328,6 +557,11 @@ template <int KIND> struct CountDimension {
     result.GetLowerBounds(at);
     INTERNAL_CHECK(result.rank() == 0 || at[0] == 1);
     using CppType = CppTypeFor<TypeCategory::Integer, KIND>;
+    CppType *p{result.OffsetElement<CppType>()};
+    if (CountDimBySweepingIfContiguous(x, dim - 1,
+            [p](std::size_t n, SubscriptValue count) { p[n] = count; })) {
+      return;
+    }
     for (auto n{result.Elements()}; n-- > 0; result.IncrementSubscripts(at)) {
       *result.Element<CppType>(at) =
           ReduceLogicalDimToScalar<CountAccumulator>(x, dim - 1, at);
@@ -10,9 +10,11 @@
 //
 // Real and complex SUM reductions attempt to reduce floating-point
 // cancellation on intermediate results by using "Kahan summation"
-// (basically the same as manual "double-double").
+// (basically the same as manual "double-double"), unless another
+// Summation method has been selected.
 
 #include "reduction-templates.h"
+#include "summation.h"
 #include "flang/Common/float128.h"
 #include "flang/Runtime/reduction.h"
 #include <cfloat>
@@ -30,46 +32,30 @@ public:
   RT_API_ATTRS void GetResult(A *p, int /*zeroBasedDim*/ = -1) const {
     *p = static_cast<A>(sum_);
   }
-  template <typename A>
-  RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
-    sum_ += *array_.Element<A>(at);
-    return true;
-  }
-
-private:
-  const Descriptor &array_;
-  INTERMEDIATE sum_{0};
-};
-
-template <typename INTERMEDIATE> class RealSumAccumulator {
-public:
-  explicit RT_API_ATTRS RealSumAccumulator(const Descriptor &array)
-      : array_{array} {}
-  void RT_API_ATTRS Reinitialize() { sum_ = correction_ = 0; }
-  template <typename A> RT_API_ATTRS A Result() const { return sum_; }
-  template <typename A>
-  RT_API_ATTRS void GetResult(A *p, int /*zeroBasedDim*/ = -1) const {
-    *p = Result<A>();
-  }
   template <typename A> RT_API_ATTRS bool Accumulate(A x) {
-    // Kahan summation
-    auto next{x + correction_};
-    auto oldSum{sum_};
-    sum_ += next;
-    correction_ = (sum_ - oldSum) - next; // algebraically zero
+    sum_ += x;
     return true;
   }
   template <typename A>
   RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
     return Accumulate(*array_.Element<A>(at));
   }
+  template <typename A>
+  RT_API_ATTRS bool AccumulateContiguous(const A *x, SubscriptValue n) {
+    sum_ = FoldContiguous(sum_, x, n, INTERMEDIATE{0},
+        [](INTERMEDIATE a, INTERMEDIATE b) { return a + b; });
+    return true;
+  }
+  RT_API_ATTRS void Merge(const IntegerSumAccumulator &that) {
+    sum_ += that.sum_;
+  }
 
 private:
   const Descriptor &array_;
-  INTERMEDIATE sum_{0.0}, correction_{0.0};
+  INTERMEDIATE sum_{0};
 };
 
-template <typename PART> class ComplexSumAccumulator {
+template <typename PART, Summation SUMMATION> class ComplexSumAccumulator {
 public:
   explicit RT_API_ATTRS ComplexSumAccumulator(const Descriptor &array)
       : array_{array} {}
@@ -92,15 +78,64 @@ public:
   RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
     return Accumulate(*array_.Element<A>(at));
   }
+  template <typename A>
+  RT_API_ATTRS bool AccumulateContiguous(const A *x, SubscriptValue n) {
+    for (SubscriptValue j{0}; j < n; ++j) {
+      Accumulate(x[j]);
+    }
+    return true;
+  }
+  RT_API_ATTRS void Merge(const ComplexSumAccumulator &that) {
+    reals_.Merge(that.reals_);
+    imaginaries_.Merge(that.imaginaries_);
+  }
 
 private:
   const Descriptor &array_;
-  RealSumAccumulator<PART> reals_{array_}, imaginaries_{array_};
+  RealSumAccumulator<PART, SUMMATION> reals_{array_}, imaginaries_{array_};
+};
+
+// Selects the summation method once for a whole SUM.
+template <TypeCategory CAT, int KIND,
+    template <typename, Summation> class ACCUMULATOR, typename INTERMEDIATE>
+static RT_API_ATTRS CppTypeFor<CAT, KIND> TotalSum(const Descriptor &x,
+    const char *source, int line, int dim, const Descriptor *mask) {
+  switch (GetSummation(Summation::Kahan)) {
+  case Summation::Naive:
+    return GetTotalReduction<CAT, KIND>(x, source, line, dim, mask,
+        ACCUMULATOR<INTERMEDIATE, Summation::Naive>{x}, "SUM");
+  case Summation::Pairwise:
+    return GetTotalReduction<CAT, KIND>(x, source, line, dim, mask,
+        ACCUMULATOR<INTERMEDIATE, Summation::Pairwise>{x}, "SUM");
+  default:
+    return GetTotalReduction<CAT, KIND>(x, source, line, dim, mask,
+        ACCUMULATOR<INTERMEDIATE, Summation::Kahan>{x}, "SUM");
+  }
+}
+
+template <Summation SUMMATION> struct SumAccumulators {
+  template <typename T> using Real = RealSumAccumulator<T, SUMMATION>;
+  template <typename T> using Complex = ComplexSumAccumulator<T, SUMMATION>;
 };
 
+template <Summation SUMMATION>
+static RT_API_ATTRS void PartialSum(Descriptor &result, const Descriptor &x,
+    int dim, const char *source, int line, const Descriptor *mask) {
+  TypedPartialNumericReduction<IntegerSumAccumulator,
+      SumAccumulators<SUMMATION>::template Real,
+      SumAccumulators<SUMMATION>::template Complex, /*MIN_REAL_KIND=*/4>(
+      result, x, dim, source, line, mask, "SUM");
+}
+
 extern "C" {
 RT_EXT_API_GROUP_BEGIN
 
+Summation RTDEF(SetSummation)(Summation summation) {
+  Summation previous{executionEnvironment.summation};
+  executionEnvironment.summation = summation;
+  return previous;
+}
+
 CppTypeFor<TypeCategory::Integer, 1> RTDEF(SumInteger1)(const Descriptor &x,
     const char *source, int line, int dim, const Descriptor *mask) {
   return GetTotalReduction<TypeCategory::Integer, 1>(x, source, line, dim, mask,
@@ -133,63 +168,70 @@ CppTypeFor<TypeCategory::Integer, 16> RTDEF(SumInteger16)(const Descriptor &x,
 // TODO: real/complex(2 & 3)
 CppTypeFor<TypeCategory::Real, 4> RTDEF(SumReal4)(const Descriptor &x,
     const char *source, int line, int dim, const Descriptor *mask) {
-  return GetTotalReduction<TypeCategory::Real, 4>(
-      x, source, line, dim, mask, RealSumAccumulator<float>{x}, "SUM");
+  return TotalSum<TypeCategory::Real, 4, RealSumAccumulator,
+      float>(x, source, line, dim, mask);
 }
 CppTypeFor<TypeCategory::Real, 8> RTDEF(SumReal8)(const Descriptor &x,
     const char *source, int line, int dim, const Descriptor *mask) {
-  return GetTotalReduction<TypeCategory::Real, 8>(
-      x, source, line, dim, mask, RealSumAccumulator<double>{x}, "SUM");
+  return TotalSum<TypeCategory::Real, 8, RealSumAccumulator,
+      double>(x, source, line, dim, mask);
 }
 #if LDBL_MANT_DIG == 64
 CppTypeFor<TypeCategory::Real, 10> RTDEF(SumReal10)(const Descriptor &x,
     const char *source, int line, int dim, const Descriptor *mask) {
-  return GetTotalReduction<TypeCategory::Real, 10>(
-      x, source, line, dim, mask, RealSumAccumulator<long double>{x}, "SUM");
+  return TotalSum<TypeCategory::Real, 10, RealSumAccumulator,
+      long double>(x, source, line, dim, mask);
 }
 #endif
 #if LDBL_MANT_DIG == 113 || HAS_FLOAT128
 CppTypeFor<TypeCategory::Real, 16> RTDEF(SumReal16)(const Descriptor &x,
     const char *source, int line, int dim, const Descriptor *mask) {
-  return GetTotalReduction<TypeCategory::Real, 16>(
-      x, source, line, dim, mask, RealSumAccumulator<long double>{x}, "SUM");
+  return TotalSum<TypeCategory::Real, 16, RealSumAccumulator,
+      long double>(x, source, line, dim, mask);
 }
 #endif
 
 void RTDEF(CppSumComplex4)(CppTypeFor<TypeCategory::Complex, 4> &result,
     const Descriptor &x, const char *source, int line, int dim,
     const Descriptor *mask) {
-  result = GetTotalReduction<TypeCategory::Complex, 4>(
-      x, source, line, dim, mask, ComplexSumAccumulator<float>{x}, "SUM");
+  result = TotalSum<TypeCategory::Complex, 4, ComplexSumAccumulator,
+      float>(x, source, line, dim, mask);
 }
 void RTDEF(CppSumComplex8)(CppTypeFor<TypeCategory::Complex, 8> &result,
     const Descriptor &x, const char *source, int line, int dim,
     const Descriptor *mask) {
-  result = GetTotalReduction<TypeCategory::Complex, 8>(
-      x, source, line, dim, mask, ComplexSumAccumulator<double>{x}, "SUM");
+  result = TotalSum<TypeCategory::Complex, 8, ComplexSumAccumulator,
+      double>(x, source, line, dim, mask);
 }
 #if LDBL_MANT_DIG == 64
 void RTDEF(CppSumComplex10)(CppTypeFor<TypeCategory::Complex, 10> &result,
     const Descriptor &x, const char *source, int line, int dim,
     const Descriptor *mask) {
-  result = GetTotalReduction<TypeCategory::Complex, 10>(
-      x, source, line, dim, mask, ComplexSumAccumulator<long double>{x}, "SUM");
+  result = TotalSum<TypeCategory::Complex, 10, ComplexSumAccumulator,
+      long double>(x, source, line, dim, mask);
 }
 #endif
 #if LDBL_MANT_DIG == 113 || HAS_FLOAT128
 void RTDEF(CppSumComplex16)(CppTypeFor<TypeCategory::Complex, 16> &result,
     const Descriptor &x, const char *source, int line, int dim,
     const Descriptor *mask) {
-  result = GetTotalReduction<TypeCategory::Complex, 16>(
-      x, source, line, dim, mask, ComplexSumAccumulator<long double>{x}, "SUM");
+  result = TotalSum<TypeCategory::Complex, 16, ComplexSumAccumulator,
+      long double>(x, source, line, dim, mask);
 }
 #endif
 
 void RTDEF(SumDim)(Descriptor &result, const Descriptor &x, int dim,
     const char *source, int line, const Descriptor *mask) {
-  TypedPartialNumericReduction<IntegerSumAccumulator, RealSumAccumulator,
-      ComplexSumAccumulator, /*MIN_REAL_KIND=*/4>(
-      result, x, dim, source, line, mask, "SUM");
+  switch (GetSummation(Summation::Kahan)) {
+  case Summation::Naive:
+    PartialSum<Summation::Naive>(result, x, dim, source, line, mask);
+    break;
+  case Summation::Pairwise:
+    PartialSum<Summation::Pairwise>(result, x, dim, source, line, mask);
+    break;
+  default:
+    PartialSum<Summation::Kahan>(result, x, dim, source, line, mask);
+  }
 }
 
 RT_EXT_API_GROUP_END
@@ -0,0 +1,213 @@
+//===-- runtime/summation.h -------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Summation methods shared by SUM, DOT_PRODUCT, and NORM2 for REAL and
+// COMPLEX terms; see Summation in flang/Runtime/reduction.h.
+
+#ifndef FORTRAN_RUNTIME_SUMMATION_H_
+#define FORTRAN_RUNTIME_SUMMATION_H_
+
+#include "environment.h"
+#include "flang/Runtime/descriptor.h"
+#include "flang/Runtime/reduction.h"
+#include <cstdint>
+#include <type_traits>
+
+namespace Fortran::runtime {
+
+// The method selected by FORT_SUMMATION or SetSummation(), or `byDefault`
+// when none has been.
+inline RT_API_ATTRS Summation GetSummation(Summation byDefault) {
+  Summation summation{executionEnvironment.summation};
+  return summation == Summation::Default ? byDefault : summation;
+}
+
+// The sum classes below share an interface: Reset(), Result(), Add(x),
+// AddTerms(n, term) to add term(0), ..., term(n-1), and Merge().
+
+// Naive summation.
+template <typename T> class NaiveSum {
+public:
+  RT_API_ATTRS void Reset() { sum_ = T{}; }
+  RT_API_ATTRS T Result() const { return sum_; }
+  template <typename A> RT_API_ATTRS void Add(A x) { sum_ += x; }
+  template <typename TERM>
+  RT_API_ATTRS void AddTerms(SubscriptValue n, const TERM &term) {
+    T sum{sum_}; // stays in a register
+    for (SubscriptValue j{0}; j < n; ++j) {
+      sum += term(j);
+    }
+    sum_ = sum;
+  }
+  RT_API_ATTRS void Merge(const NaiveSum &that) { sum_ += that.sum_; }
+
+private:
+  T sum_{};
+};
+
+// Kahan summation (basically the same as manual "double-double").
+template <typename T> class KahanSum {
+public:
+  RT_API_ATTRS void Reset() { sum_ = correction_ = T{0}; }
+  RT_API_ATTRS T Result() const { return sum_; }
+  // correction_ is the rounding error of the latest addition to sum_,
+  // which is taken back out of the next term.
+  template <typename A> RT_API_ATTRS void Add(A x) {
+    auto next{x - correction_};
+    auto oldSum{sum_};
+    sum_ += next;
+    correction_ = (sum_ - oldSum) - next; // algebraically zero
+  }
+  template <typename TERM>
+  RT_API_ATTRS void AddTerms(SubscriptValue n, const TERM &term) {
+    KahanSum sum{*this}; // stays in registers
+    for (SubscriptValue j{0}; j < n; ++j) {
+      sum.Add(term(j));
+    }
+    *this = sum;
+  }
+  RT_API_ATTRS void Merge(const KahanSum &that) {
+    // that.sum_ - that.correction_ is its compensated sum.
+    Add(-that.correction_);
+    Add(that.sum_);
+  }
+
+private:
+  T sum_{0}, correction_{0};
+};
+
+// Pairwise summation.  Terms are added into blocks of blockTerms, using
+// several independent lanes when they come from a contiguous run so that
+// the loop vectorizes, and the block sums are combined like the digits of
+// a binary counter: level k holds the sum of 2**k blocks, and two sums at
+// the same level are added and carried to the next.  Each term thus passes
+// through O(log n) additions, and the error grows accordingly.
+// T may be a REAL or std::complex<> type.
+template <typename T> class PairwiseSum {
+public:
+  RT_API_ATTRS void Reset() {
+    block_ = T{};
+    blockCount_ = 0;
+    occupied_ = 0;
+  }
+  RT_API_ATTRS T Result() const {
+    T sum{block_};
+    for (int k{0}; k < levels; ++k) {
+      if ((occupied_ >> k) & 1) {
+        sum += level_[k];
+      }
+    }
+    return sum;
+  }
+  template <typename A> RT_API_ATTRS void Add(A x) {
+    block_ += x;
+    if (++blockCount_ == blockTerms) {
+      AddBlockSum(block_);
+      block_ = T{};
+      blockCount_ = 0;
+    }
+  }
+  template <typename TERM>
+  RT_API_ATTRS void AddTerms(SubscriptValue n, const TERM &term) {
+    SubscriptValue j{0};
+    for (; j < n && blockCount_ > 0; ++j) { // finish a partial block
+      Add(term(j));
+    }
+    for (; j + blockTerms <= n; j += blockTerms) {
+      T lane[lanes]{};
+      for (SubscriptValue k{0}; k < blockTerms; k += lanes) {
+        for (int l{0}; l < lanes; ++l) {
+          lane[l] += term(j + k + l);
+        }
+      }
+      for (int width{lanes / 2}; width > 0; width /= 2) {
+        for (int l{0}; l < width; ++l) {
+          lane[l] += lane[l + width];
+        }
+      }
+      AddBlockSum(lane[0]);
+    }
+    for (; j < n; ++j) {
+      Add(term(j));
+    }
+  }
+  RT_API_ATTRS void Merge(const PairwiseSum &that) {
+    AddBlockSum(that.Result());
+  }
+
+private:
+  static constexpr int lanes{8};
+  static constexpr int blockTerms{16 * lanes};
+  // 2**levels blocks, far more than any array has, fit before the last
+  // level just accumulates.
+  static constexpr int levels{32};
+
+  RT_API_ATTRS void AddBlockSum(T sum) {
+    int k{0};
+    for (; k < levels - 1 && ((occupied_ >> k) & 1); ++k) {
+      sum += level_[k];
+    }
+    occupied_ &= ~((std::uint64_t{1} << k) - 1);
+    if ((occupied_ >> k) & 1) {
+      level_[k] += sum;
+    } else {
+      level_[k] = sum;
+      occupied_ |= std::uint64_t{1} << k;
+    }
+  }
+
+  T block_{};
+  int blockCount_{0};
+  std::uint64_t occupied_{0}; // bit k set when level_[k] holds a sum
+  T level_[levels]{};
+};
+
+// The sum class for a Summation method other than Default.
+template <typename T, Summation SUMMATION>
+using SumFor = std::conditional_t<SUMMATION == Summation::Naive, NaiveSum<T>,
+    std::conditional_t<SUMMATION == Summation::Pairwise, PairwiseSum<T>,
+        KahanSum<T>>>;
+
+// The accumulator for REAL SUM, also used for the parts of COMPLEX SUM.
+// The summation method is a template argument, chosen once by the entry
+// point, so that no per-element dispatch or unused state is carried along.
+template <typename INTERMEDIATE, Summation SUMMATION>
+class RealSumAccumulator {
+public:
+  explicit RT_API_ATTRS RealSumAccumulator(const Descriptor &array)
+      : array_{array} {}
+  void RT_API_ATTRS Reinitialize() { sum_.Reset(); }
+  template <typename A> RT_API_ATTRS A Result() const { return sum_.Result(); }
+  template <typename A>
+  RT_API_ATTRS void GetResult(A *p, int /*zeroBasedDim*/ = -1) const {
+    *p = Result<A>();
+  }
+  template <typename A> RT_API_ATTRS bool Accumulate(A x) {
+    sum_.Add(x);
+    return true;
+  }
+  template <typename A>
+  RT_API_ATTRS bool AccumulateAt(const SubscriptValue at[]) {
+    return Accumulate(*array_.Element<A>(at));
+  }
+  template <typename A>
+  RT_API_ATTRS bool AccumulateContiguous(const A *x, SubscriptValue n) {
+    sum_.AddTerms(n, [x](SubscriptValue j) { return x[j]; });
+    return true;
+  }
+  RT_API_ATTRS void Merge(const RealSumAccumulator &that) {
+    sum_.Merge(that.sum_);
+  }
+
+private:
+  const Descriptor &array_;
+  SumFor<INTERMEDIATE, SUMMATION> sum_;
+};
+
+} // namespace Fortran::runtime
+#endif // FORTRAN_RUNTIME_SUMMATION_H_
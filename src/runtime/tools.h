@@ -63,26 +63,23 @@ RT_API_ATTRS void ToFortranDefaultCharacter(
     char *to, std::size_t toLength, const char *from);
 
 // Utilities for dealing with elemental LOGICAL arguments
-inline RT_API_ATTRS bool IsLogicalElementTrue(
-    const Descriptor &logical, const SubscriptValue at[]) {
+inline RT_API_ATTRS bool IsLogicalValueTrue(
+    const char *p, std::size_t bytes) {
   // A LOGICAL value is false if and only if all of its bytes are zero.
-  const char *p{logical.Element<char>(at)};
-  for (std::size_t j{logical.ElementBytes()}; j-- > 0; ++p) {
+  for (; bytes-- > 0; ++p) {
     if (*p) {
       return true;
     }
   }
   return false;
 }
+inline RT_API_ATTRS bool IsLogicalElementTrue(
+    const Descriptor &logical, const SubscriptValue at[]) {
+  return IsLogicalValueTrue(logical.Element<char>(at), logical.ElementBytes());
+}
 inline RT_API_ATTRS bool IsLogicalScalarTrue(const Descriptor &logical) {
-  // A LOGICAL value is false if and only if all of its bytes are zero.
-  const char *p{logical.OffsetElement<char>()};
-  for (std::size_t j{logical.ElementBytes()}; j-- > 0; ++p) {
-    if (*p) {
-      return true;
-    }
-  }
-  return false;
+  return IsLogicalValueTrue(
+      logical.OffsetElement<char>(), logical.ElementBytes());
 }
 
 // Check array conformability; a scalar 'x' conforms.  Crashes on error.
@@ -18,10 +18,14 @@
 
 #include "flang/Runtime/transformational.h"
 #include "copy.h"
+#include "derived.h"
+#include "packed-mask.h"
 #include "terminator.h"
 #include "tools.h"
 #include "flang/Common/float128.h"
+#include "flang/Common/optional.h"
 #include "flang/Runtime/descriptor.h"
+#include <cstring>
 
 namespace Fortran::runtime {
 
@@ -138,6 +142,279 @@ static inline RT_API_ATTRS std::size_t AllocateResult(Descriptor &result,
   return elementLen;
 }
 
+// Stores the transpose of the `rows` x `columns` matrix at `from`, whose
+// dimensions have the byte strides `stride0` and `stride1`, into the
+// contiguous array at `to`.  The copies are done in square tiles so that
+// the loads and the stores of each tile touch only a few cache lines
+// apiece.  BYTES is as for DispatchOnElementBytes().
+template <std::size_t BYTES>
+static RT_API_ATTRS void TransposeTiles(char *to, const char *from,
+    SubscriptValue rows, SubscriptValue columns, SubscriptValue stride0,
+    SubscriptValue stride1, std::size_t bytes) {
+  constexpr SubscriptValue tile{32};
+  const std::size_t elementBytes{BYTES > 0 ? BYTES : bytes};
+  const SubscriptValue toStride{
+      columns * static_cast<SubscriptValue>(elementBytes)};
+  for (SubscriptValue i0{0}; i0 < rows; i0 += tile) {
+    SubscriptValue i1{std::min(i0 + tile, rows)};
+    for (SubscriptValue j0{0}; j0 < columns; j0 += tile) {
+      SubscriptValue j1{std::min(j0 + tile, columns)};
+      for (SubscriptValue i{i0}; i < i1; ++i) {
+        char *toColumn{to + i * toStride};
+        const char *fromRow{from + i * stride0};
+        for (SubscriptValue j{j0}; j < j1; ++j) {
+          std::memcpy(
+              toColumn + j * elementBytes, fromRow + j * stride1, elementBytes);
+        }
+      }
+    }
+  }
+}
+
+// Copies `count` elements of `from` in array element order, starting with
+// the one whose zero-based element number is `first`, into contiguous
+// storage at `to`; returns the address that follows them.  A scalar `from`
+// is replicated.  The elements must need no deep copies.
+static RT_API_ATTRS char *CopyElementsToContiguous(
+    char *to, const Descriptor &from, std::size_t first, std::size_t count) {
+  std::size_t bytes{from.ElementBytes()};
+  if (count == 0) {
+    return to;
+  } else if (from.rank() == 0) {
+    CopyStrided(to, bytes, from.OffsetElement<char>(), 0, count, bytes);
+  } else if (from.IsContiguous()) {
+    std::memcpy(to, from.OffsetElement<char>() + first * bytes, count * bytes);
+  } else {
+    // Copy a stretch along the first dimension at a time.
+    SubscriptValue at[maxRank];
+    from.SubscriptsForZeroBasedElementNumber(at, first);
+    const Dimension &dim0{from.GetDimension(0)};
+    auto extent0{static_cast<std::size_t>(dim0.Extent())};
+    for (std::size_t n{count}, offset{first % extent0}; n > 0; offset = 0) {
+      auto stretch{std::min(n, extent0 - offset)};
+      CopyStrided(to, bytes, from.Element<char>(at), dim0.ByteStride(),
+          stretch, bytes);
+      to += stretch * bytes;
+      n -= stretch;
+      at[0] = dim0.UpperBound();
+      from.IncrementSubscripts(at);
+    }
+    return to;
+  }
+  return to + count * bytes;
+}
+
+// PACK of a contiguous array whose elements have BYTES bytes apiece and need
+// no deep copies, one word of the packed MASK= at a time, into contiguous
+// storage at `to` with room for `mask.Count()` elements; returns the address
+// that follows them.  A sparse word has its true elements copied one by one;
+// a dense one is compressed without a branch per element by storing every
+// element and advancing only past the true ones, which needs a word's worth
+// of room in the result beyond the last true element.
+template <std::size_t BYTES>
+static RT_API_ATTRS char *CompressElements(
+    char *to, const char *from, const PackedMask &mask, const char *toEnd) {
+  constexpr std::size_t wordBits{PackedMask::wordBits};
+  std::size_t elements{mask.elements()};
+  for (std::size_t j{0}, words{mask.words()}; j < words; ++j) {
+    PackedMask::Word w{mask.word(j)};
+    const char *block{from + j * wordBits * BYTES};
+    std::size_t length{std::min(wordBits, elements - j * wordBits)};
+    if (w == 0) {
+      continue;
+    } else if (length == wordBits && ~w == 0) {
+      std::memcpy(to, block, wordBits * BYTES);
+      to += wordBits * BYTES;
+    } else if (common::BitPopulationCount(w) < 16 ||
+        static_cast<std::size_t>(toEnd - to) < wordBits * BYTES) {
+      for (; w != 0; w &= w - 1) {
+        std::memcpy(
+            to, block + PackedMask::TrailingZeroBitCount(w) * BYTES, BYTES);
+        to += BYTES;
+      }
+    } else {
+      for (std::size_t k{0}; k < length; ++k) {
+        std::memcpy(to, block + k * BYTES, BYTES);
+        to += ((w >> k) & 1) * BYTES;
+      }
+    }
+  }
+  return to;
+}
+
+// UNPACK into contiguous storage at `to` of elements with BYTES bytes apiece
+// that need no deep copies, from a contiguous VECTOR= and a FIELD= that is
+// contiguous (`fieldStride` == BYTES) or scalar (`fieldStride` == 0), one
+// word of the packed MASK= at a time.  Each element of a mixed word is
+// copied from an address selected without a branch.
+template <std::size_t BYTES>
+static RT_API_ATTRS void ExpandElements(char *to, const char *vector,
+    const char *field, SubscriptValue fieldStride, const PackedMask &mask) {
+  constexpr std::size_t wordBits{PackedMask::wordBits};
+  std::size_t elements{mask.elements()};
+  for (std::size_t j{0}, words{mask.words()}; j < words; ++j) {
+    PackedMask::Word w{mask.word(j)};
+    std::size_t length{std::min(wordBits, elements - j * wordBits)};
+    if (w == 0) {
+      CopyStrided<BYTES>(to, BYTES, field, fieldStride, length, BYTES);
+    } else if (length == wordBits && ~w == 0) {
+      std::memcpy(to, vector, wordBits * BYTES);
+      vector += wordBits * BYTES;
+    } else {
+      for (std::size_t k{0}; k < length; ++k) {
+        bool isTrue{((w >> k) & 1) != 0};
+        std::memcpy(to + k * BYTES, isTrue ? vector : field + k * fieldStride,
+            BYTES);
+        vector += isTrue * BYTES;
+      }
+    }
+    to += length * BYTES;
+    field += length * fieldStride;
+  }
+}
+
+// CompressElements<BYTES>() for the BYTES that suits `bytes`; returns null,
+// having done nothing, when that is 0.
+static RT_API_ATTRS char *CompressElements(char *to, const char *from,
+    std::size_t bytes, const PackedMask &mask, const char *toEnd) {
+  return DispatchOnElementBytes(bytes, [&](auto elementBytes) -> char * {
+    if constexpr (elementBytes == 0) {
+      return nullptr;
+    } else {
+      return CompressElements<elementBytes>(to, from, mask, toEnd);
+    }
+  });
+}
+
+// ExpandElements<BYTES>() for the BYTES that suits `bytes`; returns false,
+// having done nothing, when that is 0.
+static RT_API_ATTRS bool ExpandElements(char *to, const char *vector,
+    const char *field, SubscriptValue fieldStride, std::size_t bytes,
+    const PackedMask &mask) {
+  return DispatchOnElementBytes(bytes, [&](auto elementBytes) {
+    if constexpr (elementBytes == 0) {
+      return false;
+    } else {
+      ExpandElements<elementBytes>(to, vector, field, fieldStride, mask);
+      return true;
+    }
+  });
+}
+
+// CSHIFT (when `circular`) & EOSHIFT of an array whose elements need no
+// deep copies, into a newly allocated result.  Each vector section of the
+// result along DIM= is filled with at most two block copies from the same
+// section of SOURCE=, or for EOSHIFT one copy and a fill with the BOUNDARY=
+// value, if any (otherwise the result has been default-initialized).  When
+// the shift count and boundary value are the same for all sections and the
+// dimensions before DIM= are contiguous in SOURCE=, those dimensions are
+// folded into the elements, so that (e.g.) CSHIFT(A,SHIFT=1,DIM=2) of a
+// contiguous matrix moves whole columns.
+template <typename GET_SHIFT>
+static RT_API_ATTRS void ShiftSections(const Descriptor &result,
+    const Descriptor &source, int dim, bool uniformShift,
+    const GET_SHIFT &getShift, bool circular, const Descriptor *boundary) {
+  if (result.Elements() == 0) {
+    return;
+  }
+  int rank{source.rank()};
+  SubscriptValue extent[maxRank], sourceLB[maxRank];
+  source.GetShape(extent);
+  source.GetLowerBounds(sourceLB);
+  std::size_t elementBytes{source.ElementBytes()};
+  int boundaryRank{boundary ? boundary->rank() : -1};
+  int firstDim{0}; // subscripts of earlier dimensions are folded
+  SubscriptValue blockElements{1};
+  if (uniformShift && boundaryRank <= 0) {
+    auto stride{static_cast<SubscriptValue>(elementBytes)};
+    for (; firstDim < dim - 1 &&
+         source.GetDimension(firstDim).ByteStride() == stride;
+         ++firstDim) {
+      blockElements *= extent[firstDim];
+      stride *= extent[firstDim];
+    }
+    if (firstDim < dim - 1) {
+      firstDim = 0;
+      blockElements = 1;
+    }
+  }
+  std::size_t blockBytes{blockElements * elementBytes};
+  SubscriptValue dimExtent{source.GetDimension(dim - 1).Extent()};
+  SubscriptValue toStride{result.GetDimension(dim - 1).ByteStride()};
+  SubscriptValue fromStride{source.GetDimension(dim - 1).ByteStride()};
+  auto fill{[&](char *to, SubscriptValue count, const char *value) {
+    if (value) { // folded blocks of the result are contiguous
+      CopyStrided(to, blockElements > 1 ? elementBytes : toStride, value, 0,
+          count * blockElements, elementBytes);
+    }
+  }};
+  SubscriptValue resultAt[maxRank], sourceAt[maxRank], boundaryAt[maxRank];
+  for (int j{0}; j < rank; ++j) {
+    resultAt[j] = 1;
+  }
+  while (true) {
+    for (int j{0}; j < rank; ++j) {
+      sourceAt[j] = sourceLB[j] + resultAt[j] - 1;
+    }
+    sourceAt[dim - 1] = sourceLB[dim - 1];
+    char *to{result.Element<char>(resultAt)};
+    const char *from{source.Element<char>(sourceAt)};
+    SubscriptValue shift{getShift(resultAt)};
+    if (circular) {
+      shift %= dimExtent;
+      if (shift < 0) {
+        shift += dimExtent;
+      }
+      CopyStrided(to, toStride, from + shift * fromStride, fromStride,
+          dimExtent - shift, blockBytes);
+      CopyStrided(to + (dimExtent - shift) * toStride, toStride, from,
+          fromStride, shift, blockBytes);
+    } else {
+      const char *value{nullptr};
+      if (boundaryRank == 0) {
+        value = boundary->OffsetElement<char>();
+      } else if (boundaryRank > 0) {
+        for (int j{0}, k{0}; j < rank; ++j) {
+          if (j != dim - 1) {
+            boundaryAt[k] =
+                boundary->GetDimension(k).LowerBound() + resultAt[j] - 1;
+            ++k;
+          }
+        }
+        value = boundary->Element<char>(boundaryAt);
+      }
+      SubscriptValue vacated{shift >= dimExtent || shift <= -dimExtent
+              ? dimExtent
+              : shift < 0 ? -shift
+                          : shift};
+      SubscriptValue kept{dimExtent - vacated};
+      if (shift >= 0) {
+        CopyStrided(to, toStride, from + vacated * fromStride, fromStride,
+            kept, blockBytes);
+        fill(to + kept * toStride, vacated, value);
+      } else {
+        fill(to, vacated, value);
+        CopyStrided(to + vacated * toStride, toStride, from, fromStride,
+            kept, blockBytes);
+      }
+    }
+    // Advance to the next section.
+    int j{firstDim};
+    for (; j < rank; ++j) {
+      if (j != dim - 1) {
+        if (resultAt[j] < extent[j]) {
+          ++resultAt[j];
+          break;
+        }
+        resultAt[j] = 1;
+      }
+    }
+    if (j == rank) {
+      break;
+    }
+  }
+}
+
 template <TypeCategory CAT, int KIND>
 static inline RT_API_ATTRS std::size_t AllocateBesselResult(Descriptor &result,
     int32_t n1, int32_t n2, Terminator &terminator, const char *function) {
@@ -467,6 +744,13 @@ void RTDEF(Cshift)(Descriptor &result, const Descriptor &source,
   SubscriptValue extent[maxRank];
   source.GetShape(extent);
   AllocateResult(result, source, rank, extent, terminator, "CSHIFT");
+  if (!HasDynamicComponent(source)) {
+    ShiftSections(
+        result, source, dim, shift.rank() == 0,
+        [&](const SubscriptValue *at) { return shiftControl.GetShift(at); },
+        /*circular=*/true, nullptr);
+    return;
+  }
   SubscriptValue resultAt[maxRank];
   for (int j{0}; j < rank; ++j) {
     resultAt[j] = 1;
@@ -505,6 +789,12 @@ void RTDEF(CshiftVector)(Descriptor &result, const Descriptor &source,
   const Dimension &sourceDim{source.GetDimension(0)};
   SubscriptValue extent{sourceDim.Extent()};
   AllocateResult(result, source, 1, &extent, terminator, "CSHIFT");
+  if (!HasDynamicComponent(source)) {
+    ShiftSections(
+        result, source, 1, true, [=](const SubscriptValue *) { return shift; },
+        /*circular=*/true, nullptr);
+    return;
+  }
   SubscriptValue lb{sourceDim.LowerBound()};
   for (SubscriptValue j{0}; j < extent; ++j) {
     SubscriptValue resultAt{1 + j};
@@ -564,6 +854,13 @@ void RTDEF(Eoshift)(Descriptor &result, const Descriptor &source,
   if (!boundary) {
     DefaultInitialize(result, terminator);
   }
+  if (!HasDynamicComponent(source)) {
+    ShiftSections(
+        result, source, dim, shift.rank() == 0,
+        [&](const SubscriptValue *at) { return shiftControl.GetShift(at); },
+        /*circular=*/false, boundary);
+    return;
+  }
   SubscriptValue sourceLB[maxRank];
   source.GetLowerBounds(sourceLB);
   SubscriptValue boundaryAt[maxRank];
@@ -617,6 +914,12 @@ void RTDEF(EoshiftVector)(Descriptor &result, const Descriptor &source,
   if (!boundary) {
     DefaultInitialize(result, terminator);
   }
+  if (!HasDynamicComponent(source)) {
+    ShiftSections(
+        result, source, 1, true, [=](const SubscriptValue *) { return shift; },
+        /*circular=*/false, boundary);
+    return;
+  }
   SubscriptValue lb{source.GetDimension(0).LowerBound()};
   for (SubscriptValue j{1}; j <= extent; ++j) {
     SubscriptValue sourceAt{lb + j - 1 + shift};
@@ -638,19 +941,14 @@ void RTDEF(Pack)(Descriptor &result, const Descriptor &source,
   RUNTIME_CHECK(
       terminator, maskType && maskType->first == TypeCategory::Logical);
   SubscriptValue trues{0};
+  Fortran::common::optional<PackedMask> packed;
   if (mask.rank() == 0) {
     if (IsLogicalElementTrue(mask, nullptr)) {
       trues = source.Elements();
     }
   } else {
-    SubscriptValue maskAt[maxRank];
-    mask.GetLowerBounds(maskAt);
-    for (std::size_t n{mask.Elements()}; n > 0; --n) {
-      if (IsLogicalElementTrue(mask, maskAt)) {
-        ++trues;
-      }
-      mask.IncrementSubscripts(maskAt);
-    }
+    packed.emplace(mask, terminator);
+    trues = packed->Count();
   }
   SubscriptValue extent{trues};
   if (vector) {
@@ -670,6 +968,31 @@ void RTDEF(Pack)(Descriptor &result, const Descriptor &source,
     }
   }
   AllocateResult(result, source, 1, &extent, terminator, "PACK");
+  if (!HasDynamicComponent(source)) {
+    // Compress or copy each run of true elements, and then the rest of
+    // VECTOR=, at once.
+    char *to{result.OffsetElement<char>()};
+    std::size_t bytes{source.ElementBytes()};
+    char *compressed{mask.rank() > 0 && source.IsContiguous()
+            ? CompressElements(to, source.OffsetElement<char>(), bytes,
+                  *packed, to + extent * bytes)
+            : nullptr};
+    if (compressed) {
+      to = compressed;
+    } else if (mask.rank() > 0) {
+      packed->ForEachTrueRun(
+          0, source.Elements(), [&](std::size_t n, std::size_t length) {
+            to = CopyElementsToContiguous(to, source, n, length);
+            return true;
+          });
+    } else if (trues > 0) {
+      to = CopyElementsToContiguous(to, source, 0, trues);
+    }
+    if (vector) {
+      CopyElementsToContiguous(to, *vector, trues, extent - trues);
+    }
+    return;
+  }
   SubscriptValue sourceAt[maxRank], resultAt{1};
   source.GetLowerBounds(sourceAt);
   if (mask.rank() == 0) {
@@ -681,16 +1004,15 @@ void RTDEF(Pack)(Descriptor &result, const Descriptor &source,
       }
     }
   } else {
-    SubscriptValue maskAt[maxRank];
-    mask.GetLowerBounds(maskAt);
-    for (std::size_t n{source.Elements()}; n > 0; --n) {
-      if (IsLogicalElementTrue(mask, maskAt)) {
-        CopyElement(result, &resultAt, source, sourceAt, terminator);
-        ++resultAt;
-      }
-      source.IncrementSubscripts(sourceAt);
-      mask.IncrementSubscripts(maskAt);
-    }
+    packed->ForEachTrueRun(
+        0, source.Elements(), [&](std::size_t n, std::size_t length) {
+          source.SubscriptsForZeroBasedElementNumber(sourceAt, n);
+          for (; length-- > 0; ++resultAt) {
+            CopyElement(result, &resultAt, source, sourceAt, terminator);
+            source.IncrementSubscripts(sourceAt);
+          }
+          return true;
+        });
   }
   if (vector) {
     SubscriptValue vectorAt{
@@ -701,13 +1023,13 @@ void RTDEF(Pack)(Descriptor &result, const Descriptor &source,
   }
 }
 
-// RESHAPE
-// F2018 16.9.163
-void RTDEF(Reshape)(Descriptor &result, const Descriptor &source,
+// Checks the arguments of RESHAPE and extracts the extents of its result
+// and the order in which its dimensions are filled; returns its rank.
+static RT_API_ATTRS int CheckReshape(const Descriptor &source,
     const Descriptor &shape, const Descriptor *pad, const Descriptor *order,
-    const char *sourceFile, int line) {
+    SubscriptValue resultExtent[], int dimOrder[], std::size_t &resultElements,
+    Terminator &terminator) {
   // Compute and check the rank of the result.
-  Terminator terminator{sourceFile, line};
   RUNTIME_CHECK(terminator, shape.rank() == 1);
   RUNTIME_CHECK(terminator, shape.type().IsInteger());
   SubscriptValue resultRank{shape.GetDimension(0).Extent()};
@@ -718,9 +1040,8 @@ void RTDEF(Reshape)(Descriptor &result, const Descriptor &source,
   }
 
   // Extract and check the shape of the result; compute its element count.
-  SubscriptValue resultExtent[maxRank];
   std::size_t shapeElementBytes{shape.ElementBytes()};
-  std::size_t resultElements{1};
+  resultElements = 1;
   SubscriptValue shapeSubscript{shape.GetDimension(0).LowerBound()};
   for (int j{0}; j < resultRank; ++j, ++shapeSubscript) {
     auto extent{GetInt64Safe(
@@ -755,7 +1076,6 @@ void RTDEF(Reshape)(Descriptor &result, const Descriptor &source,
 
   // Extract and check the optional ORDER= argument, which must be a
   // permutation of [1..resultRank].
-  int dimOrder[maxRank];
   if (order) {
     RUNTIME_CHECK(terminator, order->rank() == 1);
     RUNTIME_CHECK(terminator, order->type().IsInteger());
@@ -785,6 +1105,29 @@ void RTDEF(Reshape)(Descriptor &result, const Descriptor &source,
       dimOrder[j] = j;
     }
   }
+  return static_cast<int>(resultRank);
+}
+
+static RT_API_ATTRS bool IsInOrder(int rank, const int dimOrder[]) {
+  for (int j{0}; j < rank; ++j) {
+    if (dimOrder[j] != j) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// RESHAPE
+// F2018 16.9.163
+void RTDEF(Reshape)(Descriptor &result, const Descriptor &source,
+    const Descriptor &shape, const Descriptor *pad, const Descriptor *order,
+    const char *sourceFile, int line) {
+  Terminator terminator{sourceFile, line};
+  SubscriptValue resultExtent[maxRank];
+  int dimOrder[maxRank];
+  std::size_t resultElements;
+  int resultRank{CheckReshape(source, shape, pad, order, resultExtent,
+      dimOrder, resultElements, terminator)};
 
   // Allocate result descriptor
   AllocateResult(
@@ -796,7 +1139,20 @@ void RTDEF(Reshape)(Descriptor &result, const Descriptor &source,
   SubscriptValue sourceSubscript[maxRank];
   source.GetLowerBounds(sourceSubscript);
   std::size_t resultElement{0};
+  std::size_t sourceElements{source.Elements()};
   std::size_t elementsFromSource{std::min(resultElements, sourceElements)};
+  if (IsInOrder(resultRank, dimOrder) && source.IsContiguous() &&
+      !HasDynamicComponent(source)) {
+    // Same storage sequence; the rest of the result, if any, comes from
+    // PAD= after having stepped through the elements copied here.
+    std::memcpy(result.OffsetElement(), source.OffsetElement(),
+        elementsFromSource * source.ElementBytes());
+    resultElement = elementsFromSource;
+    if (resultElement < resultElements) {
+      result.SubscriptsForZeroBasedElementNumber(
+          resultSubscript, resultElement);
+    }
+  }
   for (; resultElement < elementsFromSource; ++resultElement) {
     CopyElement(result, resultSubscript, source, sourceSubscript, terminator);
     source.IncrementSubscripts(sourceSubscript);
@@ -814,6 +1170,58 @@ void RTDEF(Reshape)(Descriptor &result, const Descriptor &source,
   }
 }
 
+bool RTDEF(ReshapeView)(Descriptor &result, const Descriptor &source,
+    const Descriptor &shape, const Descriptor *pad, const Descriptor *order,
+    const char *sourceFile, int line) {
+  Terminator terminator{sourceFile, line};
+  SubscriptValue resultExtent[maxRank];
+  int dimOrder[maxRank];
+  std::size_t resultElements;
+  int resultRank{CheckReshape(source, shape, pad, order, resultExtent,
+      dimOrder, resultElements, terminator)};
+  if (resultElements > source.Elements() ||
+      !IsInOrder(resultRank, dimOrder) || !source.IsContiguous()) {
+    RTNAME(Reshape)(result, source, shape, pad, order, sourceFile, line);
+    return false;
+  }
+  std::size_t elementBytes{source.ElementBytes()};
+  const DescriptorAddendum *sourceAddendum{source.Addendum()};
+  result.Establish(source.type(), elementBytes, source.OffsetElement(),
+      resultRank, resultExtent, CFI_attribute_pointer,
+      sourceAddendum != nullptr);
+  if (sourceAddendum) {
+    *result.Addendum() = *sourceAddendum;
+  }
+  SubscriptValue byteStride{static_cast<SubscriptValue>(elementBytes)};
+  for (int j{0}; j < resultRank; ++j) {
+    result.GetDimension(j).SetBounds(1, resultExtent[j]);
+    result.GetDimension(j).SetByteStride(byteStride);
+    byteStride *= resultExtent[j];
+  }
+  return true;
+}
+
+void RTDEF(CopyReshapeView)(
+    Descriptor &result, const char *sourceFile, int line) {
+  if (result.raw().attribute != CFI_attribute_pointer) {
+    return; // already a copy
+  }
+  Terminator terminator{sourceFile, line};
+  StaticDescriptor<maxRank, true, 10> staticView;
+  RUNTIME_CHECK(terminator, result.SizeInBytes() <= staticView.byteSize);
+  Descriptor &view{staticView.descriptor()};
+  view = result;
+  SubscriptValue extent[maxRank];
+  int rank{view.GetShape(extent)};
+  AllocateResult(result, view, rank, extent, terminator, "RESHAPE");
+  if (HasDynamicComponent(view)) {
+    CopyArray(result, view, terminator);
+  } else {
+    std::memcpy(result.OffsetElement(), view.OffsetElement(),
+        view.Elements() * view.ElementBytes());
+  }
+}
+
 // SPREAD
 void RTDEF(Spread)(Descriptor &result, const Descriptor &source, int dim,
     std::int64_t ncopies, const char *sourceFile, int line) {
@@ -831,7 +1239,39 @@ void RTDEF(Spread)(Descriptor &result, const Descriptor &source, int dim,
   for (int j{0}; j < rank; ++j) {
     extent[j] = j == dim - 1 ? ncopies : source.GetDimension(k++).Extent();
   }
-  AllocateResult(result, source, rank, extent, terminator, "SPREAD");
+  std::size_t bytes{
+      AllocateResult(result, source, rank, extent, terminator, "SPREAD")};
+  if (!HasDynamicComponent(source)) {
+    // The result is a sequence of NCOPIES copies of each stretch of the
+    // source that spans the dimensions before DIM=.  Write the first copy
+    // and fill in the others by doubling; replicate a lone element instead.
+    std::size_t stretch{1};
+    for (int j{0}; j < dim - 1; ++j) {
+      stretch *= extent[j];
+    }
+    std::size_t copies{static_cast<std::size_t>(ncopies)};
+    std::size_t stretches{stretch > 0 ? source.Elements() / stretch : 0};
+    char *to{result.OffsetElement<char>()};
+    SubscriptValue sourceAt[maxRank];
+    source.GetLowerBounds(sourceAt);
+    for (std::size_t n{0}; copies > 0 && n < stretches; ++n) {
+      if (stretch == 1) {
+        CopyStrided(
+            to, bytes, source.Element<char>(sourceAt), 0, copies, bytes);
+        source.IncrementSubscripts(sourceAt);
+      } else {
+        CopyElementsToContiguous(to, source, n * stretch, stretch);
+        std::size_t blockBytes{stretch * bytes};
+        for (std::size_t done{1}; done < copies;) {
+          std::size_t more{std::min(done, copies - done)};
+          std::memcpy(to + done * blockBytes, to, more * blockBytes);
+          done += more;
+        }
+      }
+      to += copies * stretch * bytes;
+    }
+    return;
+  }
   SubscriptValue resultAt[maxRank];
   for (int j{0}; j < rank; ++j) {
     resultAt[j] = 1;
@@ -855,7 +1295,21 @@ void RTDEF(Transpose)(Descriptor &result, const Descriptor &matrix,
   RUNTIME_CHECK(terminator, matrix.rank() == 2);
   SubscriptValue extent[2]{
       matrix.GetDimension(1).Extent(), matrix.GetDimension(0).Extent()};
-  AllocateResult(result, matrix, 2, extent, terminator, "TRANSPOSE");
+  std::size_t bytes{
+      AllocateResult(result, matrix, 2, extent, terminator, "TRANSPOSE")};
+  if (!HasDynamicComponent(matrix)) {
+    // No allocatable or automatic components need to be duplicated.
+    char *to{result.OffsetElement<char>()};
+    const char *from{matrix.OffsetElement<char>()};
+    SubscriptValue rows{extent[1]}, columns{extent[0]};
+    SubscriptValue stride0{matrix.GetDimension(0).ByteStride()};
+    SubscriptValue stride1{matrix.GetDimension(1).ByteStride()};
+    DispatchOnElementBytes(bytes, [&](auto elementBytes) {
+      TransposeTiles<elementBytes>(
+          to, from, rows, columns, stride0, stride1, bytes);
+    });
+    return;
+  }
   SubscriptValue resultAt[2]{1, 1};
   SubscriptValue matrixLB[2];
   matrix.GetLowerBounds(matrixLB);
@@ -886,30 +1340,52 @@ void RTDEF(Unpack)(Descriptor &result, const Descriptor &vector,
         "UNPACK: VECTOR= has element byte length %zd but FIELD= has length %zd",
         vector.ElementBytes(), elementLen);
   }
-  SubscriptValue resultAt[maxRank], maskAt[maxRank], fieldAt[maxRank],
+  SubscriptValue resultAt[maxRank], fieldAt[maxRank],
       vectorAt{vector.GetDimension(0).LowerBound()};
   for (int j{0}; j < rank; ++j) {
     resultAt[j] = 1;
   }
-  mask.GetLowerBounds(maskAt);
   field.GetLowerBounds(fieldAt);
+  PackedMask packed{mask, terminator};
   SubscriptValue vectorElements{vector.GetDimension(0).Extent()};
-  SubscriptValue vectorLeft{vectorElements};
-  for (std::size_t n{result.Elements()}; n-- > 0;) {
-    if (IsLogicalElementTrue(mask, maskAt)) {
-      if (vectorLeft-- == 0) {
-        terminator.Crash(
-            "UNPACK: VECTOR= argument has fewer elements (%d) than "
-            "MASK= has .TRUE. entries",
-            vectorElements);
-      }
+  if (packed.Count() > static_cast<std::size_t>(vectorElements)) {
+    terminator.Crash("UNPACK: VECTOR= argument has fewer elements (%d) than "
+                     "MASK= has .TRUE. entries",
+        vectorElements);
+  }
+  std::size_t elements{result.Elements()};
+  if (!HasDynamicComponent(field)) {
+    char *to{result.OffsetElement<char>()};
+    if (vector.IsContiguous() && (field.rank() == 0 || field.IsContiguous()) &&
+        ExpandElements(to, vector.OffsetElement<char>(),
+            field.OffsetElement<char>(),
+            field.rank() == 0 ? 0 : static_cast<SubscriptValue>(elementLen),
+            elementLen, packed)) {
+      return;
+    }
+    // Alternate between copying a gap of false elements from FIELD= and a
+    // run of true ones from VECTOR=.
+    std::size_t fieldElement{0}, vectorElement{0};
+    packed.ForEachTrueRun(
+        0, elements, [&](std::size_t n, std::size_t length) {
+          to = CopyElementsToContiguous(
+              to, field, fieldElement, n - fieldElement);
+          to = CopyElementsToContiguous(to, vector, vectorElement, length);
+          vectorElement += length;
+          fieldElement = n + length;
+          return true;
+        });
+    CopyElementsToContiguous(to, field, fieldElement, elements - fieldElement);
+    return;
+  }
+  for (std::size_t n{0}; n < elements; ++n) {
+    if (packed.Test(n)) {
       CopyElement(result, resultAt, vector, &vectorAt, terminator);
       ++vectorAt;
     } else {
       CopyElement(result, resultAt, field, fieldAt, terminator);
     }
     result.IncrementSubscripts(resultAt);
-    mask.IncrementSubscripts(maskAt);
     field.IncrementSubscripts(fieldAt);
   }
 }
@@ -0,0 +1,163 @@
+//===-- runtime/worker-pool.cpp -------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "worker-pool.h"
+#include "environment.h"
+#include "lock.h"
+#include <atomic>
+
+namespace Fortran::runtime {
+
+#if USE_PTHREADS && !RT_USE_PSEUDO_LOCK
+
+// Workers are started on first use and live until the program ends.  Each
+// parallel operation bumps generation_ to wake them; the calling thread
+// claims tasks alongside them and then waits for every started worker to
+// check back in, so that `arg` stays valid for as long as any of them may
+// look at it.
+class WorkerPool {
+public:
+  WorkerPool() {
+    pthread_mutex_init(&mutex_, nullptr);
+    pthread_cond_init(&wake_, nullptr);
+    pthread_cond_init(&done_, nullptr);
+  }
+
+  void Run(std::size_t tasks, ParallelTask task, void *arg, int threads) {
+    if (threads <= 1 || tasks <= 1 || inWorker_ || !busy_.Try()) {
+      RunSerially(tasks, task, arg);
+      return;
+    }
+    int helpers{Start(static_cast<int>(
+        std::min<std::size_t>(threads - 1, tasks - 1)))};
+    if (helpers == 0) {
+      busy_.Drop();
+      RunSerially(tasks, task, arg);
+      return;
+    }
+    pthread_mutex_lock(&mutex_);
+    task_ = task;
+    arg_ = arg;
+    tasks_ = tasks;
+    next_.store(0, std::memory_order_relaxed);
+    helpers_ = helpers;
+    running_ = helpers;
+    ++generation_;
+    pthread_cond_broadcast(&wake_);
+    pthread_mutex_unlock(&mutex_);
+    inWorker_ = true;
+    Work(task, arg, tasks);
+    inWorker_ = false;
+    pthread_mutex_lock(&mutex_);
+    while (running_ > 0) {
+      pthread_cond_wait(&done_, &mutex_);
+    }
+    pthread_mutex_unlock(&mutex_);
+    busy_.Drop();
+  }
+
+private:
+  static void RunSerially(std::size_t tasks, ParallelTask task, void *arg) {
+    for (std::size_t j{0}; j < tasks; ++j) {
+      task(arg, j);
+    }
+  }
+
+  // Ensures that at least `wanted` workers exist; returns how many do.
+  // New workers will take part in the operation about to be announced.
+  int Start(int wanted) {
+    pthread_mutex_lock(&mutex_);
+    startGeneration_ = generation_;
+    pthread_mutex_unlock(&mutex_);
+    while (workers_ < wanted && workers_ < maxWorkers) {
+      pthread_t thread;
+      if (pthread_create(&thread, nullptr, &WorkerMain,
+              reinterpret_cast<void *>(static_cast<std::intptr_t>(workers_))) !=
+          0) {
+        break;
+      }
+      pthread_detach(thread);
+      ++workers_;
+    }
+    return std::min(wanted, workers_);
+  }
+
+  void Work(ParallelTask task, void *arg, std::size_t tasks) {
+    for (std::size_t j{next_.fetch_add(1, std::memory_order_relaxed)};
+         j < tasks; j = next_.fetch_add(1, std::memory_order_relaxed)) {
+      task(arg, j);
+    }
+  }
+
+  static void *WorkerMain(void *);
+
+  static constexpr int maxWorkers{1023};
+  Lock busy_; // held by the thread that owns the current parallel operation
+  pthread_mutex_t mutex_;
+  pthread_cond_t wake_, done_;
+  std::uint64_t generation_{0};
+  std::uint64_t startGeneration_{0};
+  int workers_{0}; // threads started so far
+  int helpers_{0}; // workers taking part in the current operation
+  int running_{0}; // of those, the ones that have not yet finished
+  ParallelTask task_{nullptr};
+  void *arg_{nullptr};
+  std::size_t tasks_{0};
+  std::atomic<std::size_t> next_{0};
+  static thread_local bool inWorker_;
+};
+
+thread_local bool WorkerPool::inWorker_{false};
+static WorkerPool workerPool;
+
+void *WorkerPool::WorkerMain(void *id) {
+  int me{static_cast<int>(reinterpret_cast<std::intptr_t>(id))};
+  WorkerPool &pool{workerPool};
+  inWorker_ = true;
+  pthread_mutex_lock(&pool.mutex_);
+  std::uint64_t seen{pool.startGeneration_};
+  while (true) {
+    while (pool.generation_ == seen) {
+      pthread_cond_wait(&pool.wake_, &pool.mutex_);
+    }
+    seen = pool.generation_;
+    if (me >= pool.helpers_) {
+      continue; // not needed this time
+    }
+    ParallelTask task{pool.task_};
+    void *arg{pool.arg_};
+    std::size_t tasks{pool.tasks_};
+    pthread_mutex_unlock(&pool.mutex_);
+    pool.Work(task, arg, tasks);
+    pthread_mutex_lock(&pool.mutex_);
+    if (--pool.running_ == 0) {
+      pthread_cond_signal(&pool.done_);
+    }
+  }
+  return nullptr;
+}
+
+void RunParallelTasks(std::size_t tasks, ParallelTask task, void *arg) {
+  workerPool.Run(tasks, task, arg, executionEnvironment.workerThreads);
+}
+
+int ParallelThreads() { return executionEnvironment.workerThreads; }
+
+#else // no threads: everything runs on the calling thread
+
+void RunParallelTasks(std::size_t tasks, ParallelTask task, void *arg) {
+  for (std::size_t j{0}; j < tasks; ++j) {
+    task(arg, j);
+  }
+}
+
+int ParallelThreads() { return 1; }
+
+#endif
+
+} // namespace Fortran::runtime
@@ -0,0 +1,101 @@
+//===-- runtime/worker-pool.h -----------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// A pool of worker threads owned by the runtime, used to split large array
+// operations into independent tasks.  The number of threads (including the
+// calling thread) comes from FORT_NUM_THREADS and defaults to 1, in which
+// case everything runs on the calling thread.  Parallel operations requested
+// from a worker, or while another thread is using the pool, also run
+// serially on the calling thread.
+//
+// Callers are responsible for making their results independent of the number
+// of threads; tasks must write disjoint data and should not depend on which
+// thread runs them or in what order.
+
+#ifndef FORTRAN_RUNTIME_WORKER_POOL_H_
+#define FORTRAN_RUNTIME_WORKER_POOL_H_
+
+#include "flang/Common/api-attrs.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace Fortran::runtime {
+
+using ParallelTask = void (*)(void *, std::size_t);
+
+// Calls task(arg, j) for each j in [0, tasks) and returns once all have
+// completed.
+void RunParallelTasks(std::size_t tasks, ParallelTask, void *arg);
+
+// The number of threads that RunParallelTasks() may use, including the
+// calling thread; 1 when the work would run serially.
+int ParallelThreads();
+
+// Returns the number of threads worth using for an operation that performs
+// `work` units of work (elements, multiply-adds, &c.) when each thread
+// should get at least `minimumWorkPerThread` units.
+inline RT_API_ATTRS int ParallelThreadsFor(
+    std::size_t work, std::size_t minimumWorkPerThread) {
+#if !defined(RT_DEVICE_COMPILATION)
+  if (std::size_t most{work / std::max<std::size_t>(minimumWorkPerThread, 1)};
+      most > 1) {
+    return static_cast<int>(
+        std::min<std::size_t>(ParallelThreads(), most));
+  }
+#endif
+  return 1;
+}
+
+// Calls f(j) for each j in [0, tasks), possibly in parallel.
+template <typename F>
+inline RT_API_ATTRS void ParallelFor(std::size_t tasks, const F &f) {
+#if !defined(RT_DEVICE_COMPILATION)
+  if (tasks > 1) {
+    RunParallelTasks(
+        tasks,
+        [](void *arg, std::size_t j) { (*static_cast<const F *>(arg))(j); },
+        const_cast<F *>(&f));
+    return;
+  }
+#endif
+  for (std::size_t j{0}; j < tasks; ++j) {
+    f(j);
+  }
+}
+
+// Divides [0, extent) into consecutive chunks, at most `maxChunks` of them,
+// whose sizes are multiples of `align` (except possibly the last).
+class WorkSplit {
+public:
+  RT_API_ATTRS WorkSplit(
+      std::int64_t extent, std::int64_t maxChunks, std::int64_t align = 1)
+      : extent_{extent} {
+    if (extent > 0) {
+      chunkSize_ = (extent + std::max<std::int64_t>(maxChunks, 1) - 1) /
+          std::max<std::int64_t>(maxChunks, 1);
+      chunkSize_ = (chunkSize_ + align - 1) / align * align;
+      chunks_ = (extent + chunkSize_ - 1) / chunkSize_;
+    }
+  }
+  RT_API_ATTRS std::int64_t chunks() const { return chunks_; }
+  RT_API_ATTRS std::int64_t Begin(std::int64_t j) const {
+    return j * chunkSize_;
+  }
+  RT_API_ATTRS std::int64_t Size(std::int64_t j) const {
+    return std::min(chunkSize_, extent_ - j * chunkSize_);
+  }
+
+private:
+  std::int64_t extent_;
+  std::int64_t chunkSize_{1};
+  std::int64_t chunks_{0};
+};
+
+} // namespace Fortran::runtime
+#endif // FORTRAN_RUNTIME_WORKER_POOL_H_
@@ -0,0 +1,144 @@
+//===-- tests/assign.cpp --------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Tests of intrinsic assignment between sections of the same array, which
+// may be done in place or through a temporary, called from tests.zig.  Each
+// returns 0, or the line number of the first failed check.
+
+#include "flang/Runtime/assign.h"
+#include "flang/Runtime/descriptor.h"
+#include <vector>
+
+using namespace Fortran::runtime;
+using Fortran::common::TypeCategory;
+
+#define EXPECT(condition) \
+  if (!(condition)) { \
+    return __LINE__; \
+  }
+
+namespace {
+
+// A section of a REAL(8) array, as zero-based element offsets: its first
+// element, and the extent and stride of each dimension.
+struct Section {
+  SubscriptValue first;
+  SubscriptValue extent[2];
+  SubscriptValue stride[2];
+  int rank{1};
+  SubscriptValue Elements() const {
+    return rank == 1 ? extent[0] : extent[0] * extent[1];
+  }
+  // The offset of the element at zero-based position `j` in array element
+  // order.
+  SubscriptValue At(SubscriptValue j) const {
+    if (rank == 1) {
+      return first + j * stride[0];
+    }
+    return first + (j % extent[0]) * stride[0] + (j / extent[0]) * stride[1];
+  }
+};
+
+Section Vector(SubscriptValue lower, SubscriptValue upper,
+    SubscriptValue stride = 1) {
+  // Fortran's x(lower:upper:stride) of x(1:n)
+  return Section{lower - 1, {(upper - lower + stride) / stride, 1},
+      {stride, 0}, 1};
+}
+
+void EstablishSection(
+    Descriptor &desc, std::vector<double> &array, const Section &section) {
+  desc.Establish(TypeCategory::Real, 8, array.data() + section.first,
+      section.rank, section.extent);
+  for (int j{0}; j < section.rank; ++j) {
+    desc.GetDimension(j)
+        .SetBounds(1, section.extent[j])
+        .SetByteStride(section.stride[j] * sizeof(double));
+  }
+}
+
+// Assigns `from` to `to` within an array of `elements` distinct values, and
+// compares the result with that of reading all of `from` before writing
+// any of `to`.
+bool AssignsAsIfCopiedFirst(
+    SubscriptValue elements, const Section &to, const Section &from) {
+  std::vector<double> array(elements);
+  for (SubscriptValue j{0}; j < elements; ++j) {
+    array[j] = j + 1;
+  }
+  std::vector<double> expected{array};
+  std::vector<double> copy(from.Elements());
+  for (SubscriptValue j{0}; j < from.Elements(); ++j) {
+    copy[j] = array[from.At(j)];
+  }
+  for (SubscriptValue j{0}; j < to.Elements(); ++j) {
+    expected[to.At(j)] = copy[j];
+  }
+  StaticDescriptor<2> toStatic, fromStatic;
+  Descriptor &toDesc{toStatic.descriptor()};
+  Descriptor &fromDesc{fromStatic.descriptor()};
+  EstablishSection(toDesc, array, to);
+  EstablishSection(fromDesc, array, from);
+  RTNAME(Assign)(toDesc, fromDesc, __FILE__, __LINE__);
+  return array == expected;
+}
+
+} // namespace
+
+extern "C" {
+
+// Shifted vector sections overlap, but can be copied in place in one
+// direction or the other; a reversed one needs a temporary; interleaved
+// ones do not overlap at all.
+int test_overlapping_vector_assignment() {
+  constexpr SubscriptValue n{1000};
+  // x(2:n) = x(1:n-1), and the reverse
+  EXPECT(AssignsAsIfCopiedFirst(n, Vector(2, n), Vector(1, n - 1)));
+  EXPECT(AssignsAsIfCopiedFirst(n, Vector(1, n - 1), Vector(2, n)));
+  // x(3:n:2) = x(1:n-2:2), and the reverse
+  EXPECT(AssignsAsIfCopiedFirst(n, Vector(3, n, 2), Vector(1, n - 2, 2)));
+  EXPECT(AssignsAsIfCopiedFirst(n, Vector(1, n - 2, 2), Vector(3, n, 2)));
+  // x(1:n/2) = x(n/2:1:-1), and the reverse
+  EXPECT(AssignsAsIfCopiedFirst(n, Vector(1, n / 2), Vector(n / 2, 1, -1)));
+  EXPECT(AssignsAsIfCopiedFirst(n, Vector(n / 2, 1, -1), Vector(1, n / 2)));
+  // x(n:2:-1) = x(n-1:1:-1), and the reverse
+  EXPECT(AssignsAsIfCopiedFirst(n, Vector(n, 2, -1), Vector(n - 1, 1, -1)));
+  EXPECT(AssignsAsIfCopiedFirst(n, Vector(n - 1, 1, -1), Vector(n, 2, -1)));
+  // x(1:n:2) = x(2:n:2), and the reverse
+  EXPECT(AssignsAsIfCopiedFirst(n, Vector(1, n, 2), Vector(2, n, 2)));
+  EXPECT(AssignsAsIfCopiedFirst(n, Vector(2, n, 2), Vector(1, n, 2)));
+  return 0;
+}
+
+// The same for sections of a rank-2 array a(m,k).
+int test_overlapping_matrix_assignment() {
+  constexpr SubscriptValue m{37}, k{29};
+  // a(2:m,:) = a(1:m-1,:), and the reverse
+  Section lower{1, {m - 1, k}, {1, m}, 2}, upper{0, {m - 1, k}, {1, m}, 2};
+  EXPECT(AssignsAsIfCopiedFirst(m * k, lower, upper));
+  EXPECT(AssignsAsIfCopiedFirst(m * k, upper, lower));
+  // a(:,2:k) = a(:,1:k-1), and the reverse
+  Section right{m, {m, k - 1}, {1, m}, 2}, left{0, {m, k - 1}, {1, m}, 2};
+  EXPECT(AssignsAsIfCopiedFirst(m * k, right, left));
+  EXPECT(AssignsAsIfCopiedFirst(m * k, left, right));
+  // a(3:m:2,:) = a(1:m-2:2,:)
+  Section oddFrom3{2, {(m - 1) / 2, k}, {2, m}, 2};
+  Section oddFrom1{0, {(m - 1) / 2, k}, {2, m}, 2};
+  EXPECT(AssignsAsIfCopiedFirst(m * k, oddFrom3, oddFrom1));
+  // a(1,:) = a(2,:), and the reverse
+  Section row1{0, {k, 1}, {m, 0}, 1}, row2{1, {k, 1}, {m, 0}, 1};
+  EXPECT(AssignsAsIfCopiedFirst(m * k, row1, row2));
+  EXPECT(AssignsAsIfCopiedFirst(m * k, row2, row1));
+  // a(:,k:1:-1) = a(:,:)
+  Section reversed{(k - 1) * m, {m, k}, {1, -m}, 2};
+  Section whole{0, {m, k}, {1, m}, 2};
+  EXPECT(AssignsAsIfCopiedFirst(m * k, reversed, whole));
+  return 0;
+}
+
+} // extern "C"
@@ -0,0 +1,328 @@
+//===-- tests/derived.cpp -------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Tests of derived type initialization, copying, and destruction, called
+// from tests.zig.  Each returns 0, or the line number of the first failed
+// check.
+
+#include "copy.h"
+#include "derived.h"
+#include "terminator.h"
+#include "type-info.h"
+#include "flang/Runtime/descriptor.h"
+#include <cstdint>
+#include <cstring>
+
+using namespace Fortran::runtime;
+using Fortran::common::TypeCategory;
+
+#define EXPECT(condition) \
+  if (!(condition)) { \
+    return __LINE__; \
+  }
+
+namespace {
+
+// Type descriptions with the layouts of those in type-info.h, built as the
+// compiler emits them.
+struct ValueData {
+  typeInfo::Value::Genre genre{typeInfo::Value::Genre::Explicit};
+  typeInfo::TypeParameterValue value{0};
+};
+
+struct ComponentData {
+  StaticDescriptor<0> name;
+  typeInfo::Component::Genre genre;
+  std::uint8_t category;
+  std::uint8_t kind{0};
+  std::uint8_t rank{0};
+  std::uint64_t offset{0};
+  ValueData characterLen;
+  StaticDescriptor<0, true> derivedType;
+  StaticDescriptor<1, true> lenValue;
+  StaticDescriptor<2, true> bounds;
+  const char *initialization{nullptr};
+};
+static_assert(sizeof(ComponentData) == sizeof(typeInfo::Component));
+
+struct DerivedTypeData {
+  StaticDescriptor<1, true> binding;
+  StaticDescriptor<0> name;
+  std::uint64_t sizeInBytes{0};
+  StaticDescriptor<0, true> uninstantiated;
+  StaticDescriptor<1> kindParameter;
+  StaticDescriptor<1> lenParameterKind;
+  StaticDescriptor<1, true> component;
+  StaticDescriptor<1, true> procPtr;
+  StaticDescriptor<1, true> special;
+  std::uint32_t specialBitSet{0};
+  bool hasParent{false};
+  bool noInitializationNeeded{false};
+  bool noDestructionNeeded{false};
+  bool noFinalizationNeeded{true};
+};
+static_assert(sizeof(DerivedTypeData) == sizeof(typeInfo::DerivedType));
+
+template <typename A>
+void EstablishTable(Descriptor &table, A *items, SubscriptValue count) {
+  table.Establish(TypeCode{CFI_type_struct}, sizeof(A), items, 1, &count);
+}
+
+void EstablishType(DerivedTypeData &type, std::uint64_t sizeInBytes,
+    ComponentData *components, SubscriptValue count) {
+  EstablishTable(type.binding.descriptor(), &type, 0);
+  EstablishTable(type.kindParameter.descriptor(), &type, 0);
+  EstablishTable(type.lenParameterKind.descriptor(), &type, 0);
+  EstablishTable(type.procPtr.descriptor(), &type, 0);
+  EstablishTable(type.special.descriptor(), &type, 0);
+  EstablishTable(type.component.descriptor(), components, count);
+  type.sizeInBytes = sizeInBytes;
+}
+
+const typeInfo::DerivedType &AsType(const DerivedTypeData &type) {
+  return reinterpret_cast<const typeInfo::DerivedType &>(type);
+}
+
+} // namespace
+
+extern "C" {
+
+// type inner
+//   real :: x
+//   integer, allocatable :: a(:)
+// end type
+// type outer
+//   type(inner) :: c = inner(2.5, null())
+//   integer :: k
+// end type
+// The initializer of `c` holds the descriptor of c%a, but c%a must still be
+// duplicated when an `outer` is copied and deallocated when it is destroyed.
+int test_initialized_component_allocatables() {
+  Terminator terminator{__FILE__, __LINE__};
+  constexpr std::size_t aOffset{8};
+  constexpr std::size_t innerBytes{aOffset + Descriptor::SizeInBytes(1)};
+  constexpr std::size_t outerBytes{innerBytes + 8};
+
+  static DerivedTypeData inner, outer;
+  static ComponentData innerComponents[2], outerComponents[2];
+  innerComponents[0].genre = typeInfo::Component::Genre::Data;
+  innerComponents[0].category = static_cast<std::uint8_t>(TypeCategory::Real);
+  innerComponents[0].kind = 4;
+  innerComponents[1].genre = typeInfo::Component::Genre::Allocatable;
+  innerComponents[1].category =
+      static_cast<std::uint8_t>(TypeCategory::Integer);
+  innerComponents[1].kind = 4;
+  innerComponents[1].rank = 1;
+  innerComponents[1].offset = aOffset;
+  EstablishType(inner, innerBytes, innerComponents, 2);
+
+  alignas(Descriptor) static char initializer[innerBytes];
+  *reinterpret_cast<float *>(initializer) = 2.5f;
+  reinterpret_cast<Descriptor *>(initializer + aOffset)
+      ->Establish(TypeCategory::Integer, 4, nullptr, 1, nullptr,
+          CFI_attribute_allocatable);
+  outerComponents[0].genre = typeInfo::Component::Genre::Data;
+  outerComponents[0].category =
+      static_cast<std::uint8_t>(TypeCategory::Derived);
+  outerComponents[0].derivedType.descriptor().Establish(
+      TypeCode{CFI_type_struct}, sizeof inner, &inner, 0);
+  outerComponents[0].initialization = initializer;
+  outerComponents[1].genre = typeInfo::Component::Genre::Data;
+  outerComponents[1].category =
+      static_cast<std::uint8_t>(TypeCategory::Integer);
+  outerComponents[1].kind = 4;
+  outerComponents[1].offset = innerBytes;
+  EstablishType(outer, outerBytes, outerComponents, 2);
+
+  const typeInfo::DerivedType &outerType{AsType(outer)};
+  const ComponentPlan *plan{GetComponentPlan(outerType)};
+  EXPECT(plan && plan->allocatables == 1);
+
+  constexpr SubscriptValue elements{4};
+  alignas(Descriptor) static char from[elements * outerBytes],
+      to[elements * outerBytes];
+  StaticDescriptor<1, true> fromStatic, toStatic;
+  Descriptor &fromDesc{fromStatic.descriptor()};
+  Descriptor &toDesc{toStatic.descriptor()};
+  fromDesc.Establish(outerType, from, 1, &elements);
+  toDesc.Establish(outerType, to, 1, &elements);
+  EXPECT(Initialize(fromDesc, outerType, terminator) == 0);
+  EXPECT(Initialize(toDesc, outerType, terminator) == 0);
+
+  auto a{[&](char *base, SubscriptValue j) -> Descriptor & {
+    return *reinterpret_cast<Descriptor *>(base + j * outerBytes + aOffset);
+  }};
+  for (SubscriptValue j{0}; j < elements; ++j) {
+    EXPECT(*reinterpret_cast<float *>(from + j * outerBytes) == 2.5f);
+    Descriptor &fromA{a(from, j)};
+    EXPECT(!fromA.IsAllocated());
+    fromA.GetDimension(0).SetBounds(1, 3);
+    EXPECT(fromA.Allocate() == 0);
+    *fromA.OffsetElement<std::int32_t>() = static_cast<std::int32_t>(j);
+  }
+
+  CopyArray(toDesc, fromDesc, terminator);
+  for (SubscriptValue j{0}; j < elements; ++j) {
+    Descriptor &toA{a(to, j)};
+    EXPECT(toA.IsAllocated());
+    EXPECT(toA.raw().base_addr != a(from, j).raw().base_addr);
+    EXPECT(*toA.OffsetElement<std::int32_t>() == j);
+  }
+
+  Destroy(fromDesc, false, outerType, &terminator);
+  Destroy(toDesc, false, outerType, &terminator);
+  for (SubscriptValue j{0}; j < elements; ++j) {
+    EXPECT(!a(from, j).IsAllocated());
+    EXPECT(!a(to, j).IsAllocated());
+  }
+  return 0;
+}
+
+// type inner
+//   real :: x = 1.5
+//   integer :: n
+//   integer, allocatable :: a(:)
+// end type
+// type outer
+//   integer :: k = 7
+//   integer :: m
+//   type(inner) :: c
+//   real, pointer :: p
+// end type
+// Initialize() copies the image of a default-initialized `outer` into each
+// element, which must give the same values as the per-component walk that
+// it takes for a twin of `outer` with a LEN type parameter, and so without
+// a plan; the components without default initialization are zeroed.  Only
+// the elements of a non-contiguous section are written.
+int test_initialization_image() {
+  Terminator terminator{__FILE__, __LINE__};
+  constexpr std::size_t aOffset{8};
+  constexpr std::size_t innerBytes{aOffset + Descriptor::SizeInBytes(1)};
+  constexpr std::size_t cOffset{8};
+  constexpr std::size_t pOffset{cOffset + innerBytes};
+  constexpr std::size_t outerBytes{pOffset + Descriptor::SizeInBytes(0)};
+
+  static const float xInit{1.5f};
+  static const std::int32_t kInit{7};
+  static DerivedTypeData inner, outer, walkOuter;
+  static ComponentData innerComponents[3], outerComponents[4];
+  innerComponents[0].genre = typeInfo::Component::Genre::Data;
+  innerComponents[0].category = static_cast<std::uint8_t>(TypeCategory::Real);
+  innerComponents[0].kind = 4;
+  innerComponents[0].initialization = reinterpret_cast<const char *>(&xInit);
+  innerComponents[1].genre = typeInfo::Component::Genre::Data;
+  innerComponents[1].category =
+      static_cast<std::uint8_t>(TypeCategory::Integer);
+  innerComponents[1].kind = 4;
+  innerComponents[1].offset = 4;
+  innerComponents[2].genre = typeInfo::Component::Genre::Allocatable;
+  innerComponents[2].category =
+      static_cast<std::uint8_t>(TypeCategory::Integer);
+  innerComponents[2].kind = 4;
+  innerComponents[2].rank = 1;
+  innerComponents[2].offset = aOffset;
+  EstablishType(inner, innerBytes, innerComponents, 3);
+
+  outerComponents[0].genre = typeInfo::Component::Genre::Data;
+  outerComponents[0].category =
+      static_cast<std::uint8_t>(TypeCategory::Integer);
+  outerComponents[0].kind = 4;
+  outerComponents[0].initialization = reinterpret_cast<const char *>(&kInit);
+  outerComponents[1].genre = typeInfo::Component::Genre::Data;
+  outerComponents[1].category =
+      static_cast<std::uint8_t>(TypeCategory::Integer);
+  outerComponents[1].kind = 4;
+  outerComponents[1].offset = 4;
+  outerComponents[2].genre = typeInfo::Component::Genre::Data;
+  outerComponents[2].category =
+      static_cast<std::uint8_t>(TypeCategory::Derived);
+  outerComponents[2].offset = cOffset;
+  outerComponents[2].derivedType.descriptor().Establish(
+      TypeCode{CFI_type_struct}, sizeof inner, &inner, 0);
+  outerComponents[3].genre = typeInfo::Component::Genre::Pointer;
+  outerComponents[3].category = static_cast<std::uint8_t>(TypeCategory::Real);
+  outerComponents[3].kind = 4;
+  outerComponents[3].offset = pOffset;
+  EstablishType(outer, outerBytes, outerComponents, 4);
+  EstablishType(walkOuter, outerBytes, outerComponents, 4);
+  static std::int8_t lenKind{8};
+  EstablishTable(walkOuter.lenParameterKind.descriptor(), &lenKind, 1);
+
+  const typeInfo::DerivedType &outerType{AsType(outer)};
+  const typeInfo::DerivedType &walkType{AsType(walkOuter)};
+  EXPECT(GetComponentPlan(outerType) != nullptr);
+  EXPECT(GetComponentPlan(walkType) == nullptr);
+
+  // Whether element `j` of `stamped` has the values of element `j` of
+  // `walked` in its default-initialized components, and zero in the others.
+  auto same{[&](const char *stamped, const char *walked, SubscriptValue j) {
+    stamped += j * outerBytes;
+    walked += j * outerBytes;
+    auto value{[](const char *element, std::size_t offset, auto type) {
+      decltype(type) x;
+      std::memcpy(&x, element + offset, sizeof x);
+      return x;
+    }};
+    auto sameDescriptor{[&](std::size_t offset) {
+      const auto &s{*reinterpret_cast<const Descriptor *>(stamped + offset)};
+      const auto &w{*reinterpret_cast<const Descriptor *>(walked + offset)};
+      return s.raw().base_addr == nullptr && w.raw().base_addr == nullptr &&
+          s.raw().attribute == w.raw().attribute && s.rank() == w.rank() &&
+          s.type() == w.type() && s.ElementBytes() == w.ElementBytes();
+    }};
+    return value(stamped, 0, std::int32_t{}) == kInit &&
+        value(walked, 0, std::int32_t{}) == kInit &&
+        value(stamped, cOffset, float{}) == xInit &&
+        value(walked, cOffset, float{}) == xInit &&
+        sameDescriptor(cOffset + aOffset) && sameDescriptor(pOffset) &&
+        reinterpret_cast<const Descriptor *>(stamped + cOffset + aOffset)
+                ->raw()
+                .attribute == CFI_attribute_allocatable &&
+        reinterpret_cast<const Descriptor *>(stamped + pOffset)
+                ->raw()
+                .attribute == CFI_attribute_pointer &&
+        value(stamped, 4, std::int32_t{}) == 0 &&
+        value(stamped, cOffset + 4, std::int32_t{}) == 0;
+  }};
+
+  constexpr SubscriptValue elements{7};
+  constexpr char sentinel{0x5a};
+  alignas(Descriptor) static char stamped[elements * outerBytes],
+      walked[elements * outerBytes];
+  StaticDescriptor<1, true> stampedStatic;
+  StaticDescriptor<1, true, 1> walkedStatic;
+  Descriptor &stampedDesc{stampedStatic.descriptor()};
+  Descriptor &walkedDesc{walkedStatic.descriptor()};
+  // The whole array, and then every other element of it from the second.
+  for (SubscriptValue first : {0, 1}) {
+    SubscriptValue step{first + 1};
+    SubscriptValue extent{(elements - first + step - 1) / step};
+    std::memset(stamped, sentinel, sizeof stamped);
+    std::memset(walked, sentinel, sizeof walked);
+    stampedDesc.Establish(
+        outerType, stamped + first * outerBytes, 1, &extent);
+    walkedDesc.Establish(walkType, walked + first * outerBytes, 1, &extent);
+    stampedDesc.GetDimension(0).SetByteStride(step * outerBytes);
+    walkedDesc.GetDimension(0).SetByteStride(step * outerBytes);
+    EXPECT(Initialize(stampedDesc, outerType, terminator) == 0);
+    EXPECT(Initialize(walkedDesc, walkType, terminator) == 0);
+    for (SubscriptValue j{0}; j < elements; ++j) {
+      if (j >= first && (j - first) % step == 0) {
+        EXPECT(same(stamped, walked, j));
+      } else {
+        for (std::size_t b{0}; b < outerBytes; ++b) {
+          EXPECT(stamped[j * outerBytes + b] == sentinel);
+          EXPECT(walked[j * outerBytes + b] == sentinel);
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+} // extern "C"
@@ -0,0 +1,257 @@
+//===-- tests/matmul.cpp --------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Tests of batched MATMUL against MATMUL of each pair of matrices in the
+// batch, called from tests.zig.  Each returns 0, or the line number of the
+// first failed check.
+
+#include "terminator.h"
+#include "flang/Runtime/descriptor.h"
+#include "flang/Runtime/matmul.h"
+#include <complex>
+#include <csetjmp>
+#include <cstdarg>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+using namespace Fortran::runtime;
+using Fortran::common::TypeCategory;
+
+#define EXPECT(condition) \
+  if (!(condition)) { \
+    return __LINE__; \
+  }
+
+namespace {
+
+// The layout of a rank-3 operand or result in a buffer of elements: the
+// extents, and the stride of each dimension in elements.
+struct Layout {
+  SubscriptValue extent[3];
+  SubscriptValue stride[3];
+  SubscriptValue Elements() const {
+    SubscriptValue last{0};
+    for (int k{0}; k < 3; ++k) {
+      if (extent[k] == 0) {
+        return 0;
+      }
+      last += (extent[k] - 1) * stride[k];
+    }
+    return last + 1;
+  }
+  SubscriptValue At(
+      SubscriptValue i, SubscriptValue j, SubscriptValue b) const {
+    return i * stride[0] + j * stride[1] + b * stride[2];
+  }
+};
+
+// A contiguous rows x cols x batch layout, with `pad` unused elements after
+// each matrix and every `rowStep`-th row of a taller matrix.
+Layout Dense(SubscriptValue rows, SubscriptValue cols, SubscriptValue batch,
+    SubscriptValue pad = 0, SubscriptValue rowStep = 1) {
+  return Layout{{rows, cols, batch},
+      {rowStep, rows * rowStep, rows * rowStep * cols + pad}};
+}
+
+template <typename T>
+void EstablishLayout(Descriptor &desc, TypeCategory cat, int kind,
+    std::vector<T> &buffer, const Layout &layout) {
+  desc.Establish(cat, kind, buffer.data(), 3, layout.extent);
+  for (int k{0}; k < 3; ++k) {
+    desc.GetDimension(k)
+        .SetBounds(1, layout.extent[k])
+        .SetByteStride(layout.stride[k] * sizeof(T));
+  }
+}
+
+// Small whole numbers, so that every product and sum is exact and the
+// results can be compared exactly whatever order they are summed in.
+template <typename T> T Term(SubscriptValue j) {
+  double value{static_cast<double>(j % 7) - 3};
+  if constexpr (std::is_same_v<T, std::complex<double>>) {
+    return {value, static_cast<double>(j % 5) - 2};
+  } else {
+    return static_cast<T>(value);
+  }
+}
+
+// MATMUL of two rank-2 arrays of type T.
+template <typename T>
+void Matmul(Descriptor &product, const Descriptor &x, const Descriptor &y) {
+  if constexpr (std::is_same_v<T, float>) {
+    RTNAME(MatmulReal4Real4)(product, x, y, __FILE__, __LINE__);
+  } else if constexpr (std::is_same_v<T, double>) {
+    RTNAME(MatmulReal8Real8)(product, x, y, __FILE__, __LINE__);
+  } else if constexpr (std::is_same_v<T, std::complex<double>>) {
+    RTNAME(MatmulComplex8Complex8)(product, x, y, __FILE__, __LINE__);
+  } else {
+    RTNAME(MatmulInteger4Integer4)(product, x, y, __FILE__, __LINE__);
+  }
+}
+
+// Batched MATMUL of X (xLayout) and Y (yLayout) compared with MATMUL of
+// each pair.  With a resLayout, the product goes into a buffer with that
+// layout through MatmulBatchedDirect; otherwise MatmulBatched allocates it.
+template <typename T>
+bool BatchMatchesMatmul(TypeCategory cat, int kind, const Layout &xLayout,
+    const Layout &yLayout, const Layout *resLayout = nullptr) {
+  std::vector<T> x(xLayout.Elements()), y(yLayout.Elements());
+  for (SubscriptValue j{0}; j < static_cast<SubscriptValue>(x.size()); ++j) {
+    x[j] = Term<T>(j);
+  }
+  for (SubscriptValue j{0}; j < static_cast<SubscriptValue>(y.size()); ++j) {
+    y[j] = Term<T>(3 * j + 1);
+  }
+  StaticDescriptor<3> xStatic, yStatic, resultStatic;
+  Descriptor &xDesc{xStatic.descriptor()};
+  Descriptor &yDesc{yStatic.descriptor()};
+  Descriptor &result{resultStatic.descriptor()};
+  EstablishLayout(xDesc, cat, kind, x, xLayout);
+  EstablishLayout(yDesc, cat, kind, y, yLayout);
+  std::vector<T> resBuffer;
+  Layout layout;
+  if (resLayout) {
+    layout = *resLayout;
+    resBuffer.assign(layout.Elements(), T{});
+    EstablishLayout(result, cat, kind, resBuffer, layout);
+    RTNAME(MatmulBatchedDirect)(result, xDesc, yDesc, __FILE__, __LINE__);
+  } else {
+    RTNAME(MatmulBatched)(result, xDesc, yDesc, __FILE__, __LINE__);
+    if (result.rank() != 3) {
+      return false;
+    }
+    for (int k{0}; k < 3; ++k) {
+      layout.extent[k] = result.GetDimension(k).Extent();
+      layout.stride[k] = result.GetDimension(k).ByteStride() / sizeof(T);
+    }
+  }
+  SubscriptValue rows{xLayout.extent[0]}, n{xLayout.extent[1]};
+  SubscriptValue cols{yLayout.extent[1]}, batch{xLayout.extent[2]};
+  bool same{layout.extent[0] == rows && layout.extent[1] == cols &&
+      layout.extent[2] == batch};
+  for (SubscriptValue b{0}; same && b < batch; ++b) {
+    // MATMUL(X(:,:,b), Y(:,:,b))
+    StaticDescriptor<2> xbStatic, ybStatic, productStatic;
+    Descriptor &xb{xbStatic.descriptor()};
+    Descriptor &yb{ybStatic.descriptor()};
+    Descriptor &product{productStatic.descriptor()};
+    SubscriptValue xExtent[2]{rows, n}, yExtent[2]{n, cols};
+    xb.Establish(cat, kind, &x[xLayout.At(0, 0, b)], 2, xExtent);
+    yb.Establish(cat, kind, &y[yLayout.At(0, 0, b)], 2, yExtent);
+    for (int k{0}; k < 2; ++k) {
+      xb.GetDimension(k).SetByteStride(xLayout.stride[k] * sizeof(T));
+      yb.GetDimension(k).SetByteStride(yLayout.stride[k] * sizeof(T));
+    }
+    Matmul<T>(product, xb, yb);
+    const T *resultBase{
+        resLayout ? resBuffer.data() : result.OffsetElement<T>()};
+    for (SubscriptValue j{0}; j < cols; ++j) {
+      for (SubscriptValue i{0}; i < rows; ++i) {
+        same &= resultBase[layout.At(i, j, b)] ==
+            *product.OffsetElement<T>((i + j * rows) * sizeof(T));
+      }
+    }
+    product.Deallocate();
+  }
+  if (!resLayout) {
+    result.Deallocate();
+  }
+  return same;
+}
+
+std::jmp_buf crashed;
+void JumpOnCrash(const char *, int, const char *, va_list &) {
+  std::longjmp(crashed, 1);
+}
+
+// Whether MatmulBatchedDirect crashes for a result and operands of these
+// types and layouts.
+bool DirectCrashes(TypeCategory resultCat, int resultKind,
+    const Layout &resLayout, int yKind, const Layout &xLayout,
+    const Layout &yLayout) {
+  std::vector<double> x(xLayout.Elements()), y(yLayout.Elements()),
+      res(resLayout.Elements());
+  StaticDescriptor<3> xStatic, yStatic, resultStatic;
+  Descriptor &xDesc{xStatic.descriptor()};
+  Descriptor &yDesc{yStatic.descriptor()};
+  Descriptor &result{resultStatic.descriptor()};
+  EstablishLayout(xDesc, TypeCategory::Real, 8, x, xLayout);
+  EstablishLayout(yDesc, TypeCategory::Real, yKind, y, yLayout);
+  EstablishLayout(result, resultCat, resultKind, res, resLayout);
+  Terminator::RegisterCrashHandler(JumpOnCrash);
+  bool didCrash{setjmp(crashed) != 0};
+  if (!didCrash) {
+    RTNAME(MatmulBatchedDirect)(result, xDesc, yDesc, __FILE__, __LINE__);
+  }
+  Terminator::RegisterCrashHandler(nullptr);
+  return didCrash;
+}
+
+} // namespace
+
+extern "C" {
+
+int test_batched_matmul() {
+  constexpr auto real{TypeCategory::Real};
+  constexpr auto complex{TypeCategory::Complex};
+  // The square sizes with fixed-size kernels, and one beyond them.
+  for (SubscriptValue n{1}; n <= 9; ++n) {
+    EXPECT(BatchMatchesMatmul<double>(
+        real, 8, Dense(n, n, 5), Dense(n, n, 5)));
+    EXPECT(BatchMatchesMatmul<float>(
+        real, 4, Dense(n, n, 3), Dense(n, n, 3)));
+  }
+  EXPECT(BatchMatchesMatmul<std::complex<double>>(
+      complex, 8, Dense(3, 3, 4), Dense(3, 3, 4)));
+  EXPECT(BatchMatchesMatmul<std::int32_t>(
+      TypeCategory::Integer, 4, Dense(4, 4, 3), Dense(4, 4, 3)));
+  // Not square.
+  EXPECT(BatchMatchesMatmul<double>(real, 8, Dense(3, 5, 4), Dense(5, 2, 4)));
+  // Padding between the matrices of the batch, with the fixed-size kernel
+  // and without it.
+  Layout padded{Dense(4, 4, 6, 3)};
+  EXPECT(BatchMatchesMatmul<double>(
+      real, 8, padded, Dense(4, 4, 6, 5), &padded));
+  Layout paddedResult{Dense(3, 2, 4, 1)};
+  EXPECT(BatchMatchesMatmul<double>(
+      real, 8, Dense(3, 5, 4, 2), Dense(5, 2, 4, 7), &paddedResult));
+  // Rows that are not contiguous take the general path.
+  EXPECT(BatchMatchesMatmul<double>(
+      real, 8, Dense(4, 4, 3, 0, 2), Dense(4, 4, 3)));
+  Layout stridedResult{Dense(3, 2, 4, 0, 3)};
+  EXPECT(BatchMatchesMatmul<double>(
+      real, 8, Dense(3, 5, 4), Dense(5, 2, 4, 0, 2), &stridedResult));
+  // An empty batch.
+  EXPECT(BatchMatchesMatmul<double>(real, 8, Dense(3, 3, 0), Dense(3, 3, 0)));
+  Layout empty{Dense(3, 3, 0)};
+  EXPECT(BatchMatchesMatmul<double>(
+      real, 8, Dense(3, 3, 0), Dense(3, 3, 0), &empty));
+  return 0;
+}
+
+// MatmulBatchedDirect checks its result against the operands.
+int test_batched_matmul_direct_checks() {
+  constexpr auto real{TypeCategory::Real};
+  Layout x{Dense(3, 5, 4)}, y{Dense(5, 2, 4)};
+  EXPECT(!DirectCrashes(real, 8, Dense(3, 2, 4), 8, x, y));
+  // Result shape
+  EXPECT(DirectCrashes(real, 8, Dense(2, 2, 4), 8, x, y));
+  EXPECT(DirectCrashes(real, 8, Dense(3, 3, 4), 8, x, y));
+  EXPECT(DirectCrashes(real, 8, Dense(3, 2, 3), 8, x, y));
+  // Result type
+  EXPECT(DirectCrashes(real, 4, Dense(3, 2, 4), 8, x, y));
+  EXPECT(DirectCrashes(TypeCategory::Integer, 8, Dense(3, 2, 4), 8, x, y));
+  // Operand shapes and types
+  EXPECT(DirectCrashes(real, 8, Dense(3, 2, 4), 8, x, Dense(4, 2, 4)));
+  EXPECT(DirectCrashes(real, 8, Dense(3, 2, 4), 8, x, Dense(5, 2, 3)));
+  EXPECT(DirectCrashes(real, 8, Dense(3, 2, 4), 4, x, y));
+  return 0;
+}
+
+} // extern "C"
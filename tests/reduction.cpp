@@ -0,0 +1,483 @@
+//===-- tests/reduction.cpp -----------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Tests of reduction intrinsics over arrays large enough to be reduced in
+// parallel chunks, called from tests.zig.  Each returns 0, or the line
+// number of the first failed check.
+
+#include "environment.h"
+#include "flang/Runtime/descriptor.h"
+#include "flang/Runtime/reduce.h"
+#include "flang/Runtime/reduction.h"
+#include <cmath>
+#include <cstdlib>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+using namespace Fortran::runtime;
+using Fortran::common::TypeCategory;
+
+#define EXPECT(condition) \
+  if (!(condition)) { \
+    return __LINE__; \
+  }
+
+namespace {
+
+// Large enough for the chunked reduction, and not a whole number of chunks.
+constexpr SubscriptValue largeElements{(SubscriptValue{1} << 20) + 12345};
+
+// A linear congruential generator, so that the data are the same on every
+// run and target.
+class Random {
+public:
+  std::uint32_t Next() {
+    state_ = state_ * 6364136223846793005u + 1442695040888963407u;
+    return static_cast<std::uint32_t>(state_ >> 32);
+  }
+  // In [0, 1).
+  double Uniform() { return Next() * 0x1p-32; }
+
+private:
+  std::uint64_t state_{1};
+};
+
+bool SameBits(double x, double y) {
+  return std::memcmp(&x, &y, sizeof x) == 0;
+}
+
+// Calls `reduce` with one thread and then with several; returns true when
+// all of the results have the same bits.
+template <typename F> bool SameForAnyThreadCount(const F &reduce) {
+  int savedThreads{executionEnvironment.workerThreads};
+  executionEnvironment.workerThreads = 1;
+  double serial{reduce()};
+  bool same{true};
+  for (int threads : {2, 3, 8}) {
+    executionEnvironment.workerThreads = threads;
+    same &= SameBits(reduce(), serial);
+  }
+  executionEnvironment.workerThreads = savedThreads;
+  return same;
+}
+
+// REDUCE operations that compose affine maps t -> a*t + b, applying the
+// left operand first.  Composition is associative but not commutative, so
+// a reduction that combines its chunks out of element order gets a
+// different answer.
+//
+// As INTEGER(8): a in the high 32 bits and b in the low 32 bits, modulo
+// 2**32.
+std::int64_t ComposeAffine(std::int64_t x, std::int64_t y) {
+  std::uint32_t xa{static_cast<std::uint32_t>(std::uint64_t(x) >> 32)};
+  std::uint32_t xb{static_cast<std::uint32_t>(x)};
+  std::uint32_t ya{static_cast<std::uint32_t>(std::uint64_t(y) >> 32)};
+  std::uint32_t yb{static_cast<std::uint32_t>(y)};
+  std::uint32_t a{ya * xa}, b{ya * xb + yb};
+  return static_cast<std::int64_t>((std::uint64_t{a} << 32) | b);
+}
+std::int64_t ComposeAffineRef(const std::int64_t *x, const std::int64_t *y) {
+  return ComposeAffine(*x, *y);
+}
+
+// As CHARACTER(4): a in the first two and b in the last two characters,
+// modulo 2**16.
+constexpr std::size_t affineChars{4};
+std::uint16_t GetHalf(const char *p) {
+  return static_cast<std::uint16_t>(static_cast<unsigned char>(p[0]) |
+      static_cast<unsigned char>(p[1]) << 8);
+}
+void SetHalf(char *p, std::uint16_t x) {
+  p[0] = static_cast<char>(x & 0xff);
+  p[1] = static_cast<char>(x >> 8);
+}
+void ComposeAffineChars(char *result, std::size_t resultLen, const char *x,
+    const char *y, std::size_t xLen, std::size_t yLen) {
+  if (resultLen != affineChars || xLen != affineChars || yLen != affineChars) {
+    std::abort();
+  }
+  std::uint16_t xa{GetHalf(x)}, xb{GetHalf(x + 2)};
+  std::uint16_t ya{GetHalf(y)}, yb{GetHalf(y + 2)};
+  SetHalf(result, static_cast<std::uint16_t>(ya * xa));
+  SetHalf(result + 2, static_cast<std::uint16_t>(ya * xb + yb));
+}
+
+// MAXLOC or MINLOC of a contiguous vector, as a one-based position.
+template <typename T>
+SubscriptValue Location(bool isMax, std::vector<T> &x, bool back = false) {
+  constexpr auto cat{std::is_integral_v<T> ? TypeCategory::Integer
+                                           : TypeCategory::Real};
+  SubscriptValue extent{static_cast<SubscriptValue>(x.size())};
+  StaticDescriptor<1> xStatic, resultStatic;
+  Descriptor &xDesc{xStatic.descriptor()};
+  Descriptor &result{resultStatic.descriptor()};
+  xDesc.Establish(cat, sizeof(T), x.data(), 1, &extent);
+  auto locate{isMax ? RTNAME(MaxlocReal8) : RTNAME(MinlocReal8)};
+  if constexpr (std::is_same_v<T, float>) {
+    locate = isMax ? RTNAME(MaxlocReal4) : RTNAME(MinlocReal4);
+  } else if constexpr (std::is_same_v<T, std::int32_t>) {
+    locate = isMax ? RTNAME(MaxlocInteger4) : RTNAME(MinlocInteger4);
+  }
+  locate(result, xDesc, 8, __FILE__, __LINE__, nullptr, back);
+  SubscriptValue at{*result.OffsetElement<std::int64_t>()};
+  result.Deallocate();
+  return at;
+}
+
+// MAXLOC and MINLOC of REAL data skip NaNs, unless every element is a NaN;
+// ties go to the first element, or to the last with BACK=.  The data are
+// long enough that the values compared lie in different vector lanes.
+template <typename T> int CheckRealLocations() {
+  constexpr T nan{std::numeric_limits<T>::quiet_NaN()};
+  constexpr T inf{std::numeric_limits<T>::infinity()};
+  constexpr SubscriptValue n{37};
+  // Leading NaNs, more of them than there are lanes.
+  std::vector<T> x(n, nan);
+  for (SubscriptValue j{11}; j < n; ++j) {
+    x[j] = static_cast<T>(j % 5);
+  }
+  x[20] = -1; // the only minimum
+  EXPECT(Location(true, x) == 15); // first of the 4s
+  EXPECT(Location(true, x, true) == 35); // last of the 4s
+  EXPECT(Location(false, x) == 21);
+  EXPECT(Location(false, x, true) == 21);
+  // Ties in several lanes, with a NaN between them.
+  std::vector<T> y(n, 0);
+  y[3] = y[12] = y[29] = 7;
+  y[5] = y[22] = y[30] = -7;
+  y[17] = nan;
+  EXPECT(Location(true, y) == 4);
+  EXPECT(Location(true, y, true) == 30);
+  EXPECT(Location(false, y) == 6);
+  EXPECT(Location(false, y, true) == 31);
+  // All NaN: the first element, or the last with BACK=.
+  std::vector<T> z(n, nan);
+  EXPECT(Location(true, z) == 1);
+  EXPECT(Location(true, z, true) == n);
+  EXPECT(Location(false, z) == 1);
+  EXPECT(Location(false, z, true) == n);
+  // Only NaNs and infinities that are never better than the kernel's
+  // initial values.
+  z[6] = z[25] = -inf;
+  EXPECT(Location(true, z) == 7);
+  EXPECT(Location(true, z, true) == 26);
+  z[6] = z[25] = inf;
+  EXPECT(Location(false, z) == 7);
+  EXPECT(Location(false, z, true) == 26);
+  return 0;
+}
+
+// The four statistics of `x` (with `mask`, if not null) from the fused
+// call, with the results that are not requested in `want` left null,
+// compared with separate calls.  MINVAL and MAXVAL must be identical; SUM
+// and NORM2 may be reduced in other chunks, so they need only be close.
+bool FusedMatchesSeparate(const Descriptor &x, const Descriptor *mask,
+    const bool (&want)[4]) {
+  constexpr double untouched{-12345};
+  double fused[4]{untouched, untouched, untouched, untouched};
+  RTNAME(MinMaxSumNorm2Real8)
+  (want[0] ? &fused[0] : nullptr, want[1] ? &fused[1] : nullptr,
+      want[2] ? &fused[2] : nullptr, want[3] ? &fused[3] : nullptr, x,
+      __FILE__, __LINE__, mask);
+  double separate[4]{RTNAME(MinvalReal8)(x, __FILE__, __LINE__, 0, mask),
+      RTNAME(MaxvalReal8)(x, __FILE__, __LINE__, 0, mask),
+      RTNAME(SumReal8)(x, __FILE__, __LINE__, 0, mask), 0};
+  if (mask) { // NORM2 has no MASK=; take it of the selected elements.
+    std::vector<double> selected;
+    for (std::size_t j{0}; j < x.Elements(); ++j) {
+      if (*mask->OffsetElement<std::uint8_t>(j)) {
+        selected.push_back(*x.OffsetElement<double>(j * sizeof(double)));
+      }
+    }
+    SubscriptValue extent{static_cast<SubscriptValue>(selected.size())};
+    StaticDescriptor<1> selectedStatic;
+    Descriptor &selectedDesc{selectedStatic.descriptor()};
+    selectedDesc.Establish(
+        TypeCategory::Real, 8, selected.data(), 1, &extent);
+    separate[3] = RTNAME(Norm2_8)(selectedDesc, __FILE__, __LINE__);
+  } else {
+    separate[3] = RTNAME(Norm2_8)(x, __FILE__, __LINE__);
+  }
+  for (int j{0}; j < 4; ++j) {
+    if (!want[j]) {
+      if (fused[j] != untouched) {
+        return false;
+      }
+    } else if (j < 2 ? !SameBits(fused[j], separate[j])
+                     : std::abs(fused[j] - separate[j]) >
+                           1e-11 * std::abs(separate[j])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+extern "C" {
+
+// SUM under every summation method, NORM2, and PRODUCT, with and without
+// MASK=, must not depend on the number of threads.
+int test_parallel_reductions_reproducible() {
+  Random random;
+  std::vector<double> x(largeElements), y(largeElements);
+  std::vector<std::uint8_t> mask(largeElements);
+  for (SubscriptValue j{0}; j < largeElements; ++j) {
+    // Mixed signs and magnitudes from 1e-3 to 1e3, so that the rounding
+    // of a sum depends on the order of its terms.
+    x[j] = (random.Uniform() - 0.5) * std::pow(10.0, random.Next() % 7 - 3.0);
+    y[j] = 1 + (random.Uniform() - 0.5) * 1e-3;
+    mask[j] = random.Next() % 3 != 0;
+  }
+  StaticDescriptor<1> xStatic, yStatic, maskStatic;
+  Descriptor &xDesc{xStatic.descriptor()};
+  Descriptor &yDesc{yStatic.descriptor()};
+  Descriptor &maskDesc{maskStatic.descriptor()};
+  xDesc.Establish(TypeCategory::Real, 8, x.data(), 1, &largeElements);
+  yDesc.Establish(TypeCategory::Real, 8, y.data(), 1, &largeElements);
+  maskDesc.Establish(TypeCategory::Logical, 1, mask.data(), 1, &largeElements);
+
+  for (Summation summation : {Summation::Default, Summation::Naive,
+           Summation::Kahan, Summation::Pairwise}) {
+    Summation saved{RTNAME(SetSummation)(summation)};
+    bool sum{SameForAnyThreadCount(
+        [&]() { return RTNAME(SumReal8)(xDesc, __FILE__, __LINE__); })};
+    bool maskedSum{SameForAnyThreadCount([&]() {
+      return RTNAME(SumReal8)(xDesc, __FILE__, __LINE__, 0, &maskDesc);
+    })};
+    bool norm2{SameForAnyThreadCount(
+        [&]() { return RTNAME(Norm2_8)(xDesc, __FILE__, __LINE__); })};
+    RTNAME(SetSummation)(saved);
+    EXPECT(sum);
+    EXPECT(maskedSum);
+    EXPECT(norm2);
+  }
+  EXPECT(SameForAnyThreadCount(
+      [&]() { return RTNAME(ProductReal8)(yDesc, __FILE__, __LINE__); }));
+  EXPECT(SameForAnyThreadCount([&]() {
+    return RTNAME(ProductReal8)(yDesc, __FILE__, __LINE__, 0, &maskDesc);
+  }));
+
+  // The results are still close to the exact ones.
+  long double exactSum{0};
+  for (double term : x) {
+    exactSum += term;
+  }
+  double sum{RTNAME(SumReal8)(xDesc, __FILE__, __LINE__)};
+  EXPECT(std::abs(sum - exactSum) <= 1e-9 * std::abs(exactSum));
+  return 0;
+}
+
+// 1 followed by terms that are each less than half an ulp of 1: summing
+// them one at a time never moves away from 1, and neither does Kahan
+// summation that adds its correction back in rather than subtracting it.
+int test_kahan_sum() {
+  constexpr SubscriptValue elements{100001};
+  constexpr double tiny{1e-16};
+  std::vector<double> x(elements, tiny);
+  std::vector<std::complex<double>> z(elements, {tiny, -tiny});
+  x[0] = 1;
+  z[0] = {1, -1};
+  StaticDescriptor<1> xStatic, zStatic;
+  Descriptor &xDesc{xStatic.descriptor()};
+  Descriptor &zDesc{zStatic.descriptor()};
+  xDesc.Establish(TypeCategory::Real, 8, x.data(), 1, &elements);
+  zDesc.Establish(TypeCategory::Complex, 8, z.data(), 1, &elements);
+  double expected{1 + (elements - 1) * tiny};
+  double tolerance{4 * std::numeric_limits<double>::epsilon()};
+
+  Summation saved{RTNAME(SetSummation)(Summation::Kahan)};
+  double sum{RTNAME(SumReal8)(xDesc, __FILE__, __LINE__)};
+  std::complex<double> complexSum;
+  RTNAME(CppSumComplex8)(complexSum, zDesc, __FILE__, __LINE__);
+  RTNAME(SetSummation)(saved);
+  EXPECT(std::abs(sum - expected) <= tolerance);
+  EXPECT(std::abs(complexSum.real() - expected) <= tolerance);
+  EXPECT(std::abs(complexSum.imag() + expected) <= tolerance);
+  return 0;
+}
+
+// REDUCE with ORDERED=.FALSE. may reduce a large array in chunks on
+// several threads, but must still combine them in array element order.
+int test_unordered_reduce() {
+  constexpr SubscriptValue elements{(SubscriptValue{1} << 20) + 777};
+  Random random;
+  std::vector<std::int64_t> x(elements);
+  std::vector<std::uint8_t> mask(elements);
+  for (SubscriptValue j{0}; j < elements; ++j) {
+    // Odd multipliers, so that no information is lost to a zero product.
+    std::uint64_t a{random.Next() | 1u}, b{random.Next()};
+    x[j] = static_cast<std::int64_t>((a << 32) | b);
+    mask[j] = random.Next() % 3 != 0;
+  }
+  std::int64_t expected{x[0]}, expectedMasked{0};
+  bool anyMasked{false};
+  for (SubscriptValue j{0}; j < elements; ++j) {
+    if (j > 0) {
+      expected = ComposeAffine(expected, x[j]);
+    }
+    if (mask[j]) {
+      expectedMasked = anyMasked ? ComposeAffine(expectedMasked, x[j]) : x[j];
+      anyMasked = true;
+    }
+  }
+  StaticDescriptor<1> xStatic, maskStatic;
+  Descriptor &xDesc{xStatic.descriptor()};
+  Descriptor &maskDesc{maskStatic.descriptor()};
+  xDesc.Establish(TypeCategory::Integer, 8, x.data(), 1, &elements);
+  maskDesc.Establish(TypeCategory::Logical, 1, mask.data(), 1, &elements);
+
+  int savedThreads{executionEnvironment.workerThreads};
+  for (int threads : {1, 2, 3, 8}) {
+    executionEnvironment.workerThreads = threads;
+    std::int64_t result{RTNAME(ReduceInteger8Value)(xDesc, ComposeAffine,
+        __FILE__, __LINE__, 0, nullptr, nullptr, /*ordered=*/false)};
+    std::int64_t masked{RTNAME(ReduceInteger8Ref)(xDesc, ComposeAffineRef,
+        __FILE__, __LINE__, 0, &maskDesc, nullptr, /*ordered=*/false)};
+    if (result != expected || masked != expectedMasked) {
+      executionEnvironment.workerThreads = savedThreads;
+      return __LINE__;
+    }
+  }
+  executionEnvironment.workerThreads = savedThreads;
+  return 0;
+}
+
+// The same for CHARACTER, whose accumulator holds its partial result in a
+// buffer that each chunk's copy must own.
+int test_unordered_reduce_character() {
+  constexpr SubscriptValue elements{(SubscriptValue{1} << 20) + 777};
+  Random random;
+  std::vector<char> x(elements * affineChars);
+  std::vector<std::uint8_t> mask(elements);
+  for (SubscriptValue j{0}; j < elements; ++j) {
+    char *element{&x[j * affineChars]};
+    SetHalf(element, static_cast<std::uint16_t>(random.Next() | 1u));
+    SetHalf(element + 2, static_cast<std::uint16_t>(random.Next()));
+    mask[j] = random.Next() % 3 != 0;
+  }
+  char expected[affineChars], expectedMasked[affineChars], next[affineChars];
+  std::memcpy(expected, &x[0], affineChars);
+  bool anyMasked{false};
+  for (SubscriptValue j{0}; j < elements; ++j) {
+    const char *element{&x[j * affineChars]};
+    if (j > 0) {
+      ComposeAffineChars(
+          next, affineChars, expected, element, affineChars, affineChars);
+      std::memcpy(expected, next, affineChars);
+    }
+    if (mask[j]) {
+      if (anyMasked) {
+        ComposeAffineChars(next, affineChars, expectedMasked, element,
+            affineChars, affineChars);
+        std::memcpy(expectedMasked, next, affineChars);
+      } else {
+        std::memcpy(expectedMasked, element, affineChars);
+      }
+      anyMasked = true;
+    }
+  }
+  StaticDescriptor<1> xStatic, maskStatic;
+  Descriptor &xDesc{xStatic.descriptor()};
+  Descriptor &maskDesc{maskStatic.descriptor()};
+  xDesc.Establish(1, affineChars, x.data(), 1, &elements);
+  maskDesc.Establish(TypeCategory::Logical, 1, mask.data(), 1, &elements);
+
+  int savedThreads{executionEnvironment.workerThreads};
+  for (int threads : {1, 2, 3, 8}) {
+    executionEnvironment.workerThreads = threads;
+    char result[affineChars], masked[affineChars];
+    RTNAME(ReduceChar1)(result, xDesc, ComposeAffineChars, __FILE__,
+        __LINE__, 0, nullptr, nullptr, /*ordered=*/false);
+    RTNAME(ReduceChar1)(masked, xDesc, ComposeAffineChars, __FILE__,
+        __LINE__, 0, &maskDesc, nullptr, /*ordered=*/false);
+    if (std::memcmp(result, expected, affineChars) != 0 ||
+        std::memcmp(masked, expectedMasked, affineChars) != 0) {
+      executionEnvironment.workerThreads = savedThreads;
+      return __LINE__;
+    }
+  }
+  executionEnvironment.workerThreads = savedThreads;
+  return 0;
+}
+
+// MinMaxSumNorm2Real8 gives the results of MINVAL, MAXVAL, SUM and NORM2,
+// with and without MASK=, on either side of its 1024-element slices and of
+// the size at which reductions are split into chunks.
+int test_min_max_sum_norm2() {
+  constexpr bool all[4]{true, true, true, true};
+  constexpr bool subsets[][4]{{true, false, false, false},
+      {false, true, true, false}, {false, false, false, true},
+      {true, false, true, true}, {false, false, false, false}};
+  for (SubscriptValue elements : {SubscriptValue{1}, SubscriptValue{1000},
+           SubscriptValue{1024}, SubscriptValue{1025}, SubscriptValue{5000},
+           (SubscriptValue{1} << 20) - 1, largeElements}) {
+    Random random;
+    std::vector<double> x(elements);
+    std::vector<std::uint8_t> mask(elements), none(elements, 0);
+    for (SubscriptValue j{0}; j < elements; ++j) {
+      x[j] = (random.Uniform() - 0.5) * std::pow(10.0, random.Next() % 7 - 3.0);
+      mask[j] = random.Next() % 3 != 0;
+    }
+    mask[0] = 1;
+    StaticDescriptor<1> xStatic, maskStatic, noneStatic;
+    Descriptor &xDesc{xStatic.descriptor()};
+    Descriptor &maskDesc{maskStatic.descriptor()};
+    Descriptor &noneDesc{noneStatic.descriptor()};
+    xDesc.Establish(TypeCategory::Real, 8, x.data(), 1, &elements);
+    maskDesc.Establish(TypeCategory::Logical, 1, mask.data(), 1, &elements);
+    noneDesc.Establish(TypeCategory::Logical, 1, none.data(), 1, &elements);
+    EXPECT(FusedMatchesSeparate(xDesc, nullptr, all));
+    EXPECT(FusedMatchesSeparate(xDesc, &maskDesc, all));
+    EXPECT(FusedMatchesSeparate(xDesc, &noneDesc, all));
+    for (const auto &want : subsets) {
+      EXPECT(FusedMatchesSeparate(xDesc, nullptr, want));
+      EXPECT(FusedMatchesSeparate(xDesc, &maskDesc, want));
+    }
+    // No element is selected: the identities of each reduction.
+    double minval, maxval, sum, norm2;
+    RTNAME(MinMaxSumNorm2Real8)
+    (&minval, &maxval, &sum, &norm2, xDesc, __FILE__, __LINE__, &noneDesc);
+    EXPECT(minval == std::numeric_limits<double>::max());
+    EXPECT(maxval == -std::numeric_limits<double>::max());
+    EXPECT(sum == 0 && norm2 == 0);
+  }
+  return 0;
+}
+
+// MAXLOC and MINLOC of contiguous data, which have their own kernel.
+int test_maxloc_minloc() {
+  if (int line{CheckRealLocations<double>()}) {
+    return line;
+  }
+  if (int line{CheckRealLocations<float>()}) {
+    return line;
+  }
+  // INTEGER ties, including at the values the kernel starts from.
+  constexpr SubscriptValue n{37};
+  std::vector<std::int32_t> i(n, 1);
+  i[9] = i[18] = i[27] = 5;
+  EXPECT(Location(true, i) == 10);
+  EXPECT(Location(true, i, true) == 28);
+  EXPECT(Location(false, i) == 1);
+  EXPECT(Location(false, i, true) == n);
+  using Limits = std::numeric_limits<std::int32_t>;
+  std::vector<std::int32_t> lowest(n, Limits::min());
+  EXPECT(Location(true, lowest) == 1);
+  EXPECT(Location(true, lowest, true) == n);
+  std::vector<std::int32_t> highest(n, Limits::max());
+  EXPECT(Location(false, highest) == 1);
+  EXPECT(Location(false, highest, true) == n);
+  return 0;
+}
+
+} // extern "C"
@@ -49,3 +49,240 @@ test "test_CFI_establish_allocate" {
 
     try std.testing.expectEqual(null, source_desc.base_addr);
 }
+
+// MATMUL and DOT_PRODUCT entry points, and the BLAS dispatch table of
+// flang/Runtime/matmul.h, for a registered table whose routines count their
+// calls before forwarding them to the runtime's reference implementations.
+extern fn _FortranAMatmulReal8Real8(
+    result: *flang.CFI_cdesc_t,
+    x: *const flang.CFI_cdesc_t,
+    y: *const flang.CFI_cdesc_t,
+    source_file: ?[*:0]const u8,
+    line: c_int,
+) void;
+extern fn _FortranADotProductReal8(
+    x: *const flang.CFI_cdesc_t,
+    y: *const flang.CFI_cdesc_t,
+    source_file: ?[*:0]const u8,
+    line: c_int,
+) f64;
+
+const Dgemm = *const fn ([*c]const u8, [*c]const u8, *const c_int, *const c_int, *const c_int, *const f64, [*c]const f64, *const c_int, [*c]const f64, *const c_int, *const f64, [*c]f64, *const c_int) callconv(.C) void;
+const Dgemv = *const fn ([*c]const u8, *const c_int, *const c_int, *const f64, [*c]const f64, *const c_int, [*c]const f64, *const c_int, *const f64, [*c]f64, *const c_int) callconv(.C) void;
+const Ddot = *const fn (*const c_int, [*c]const f64, *const c_int, [*c]const f64, *const c_int) callconv(.C) f64;
+
+const BlasFunctions = extern struct {
+    sgemm: ?*const anyopaque,
+    dgemm: ?Dgemm,
+    sgemv: ?*const anyopaque,
+    dgemv: ?Dgemv,
+    sdot: ?*const anyopaque,
+    ddot: ?Ddot,
+    minimumWork: usize,
+};
+
+extern fn _FortranARegisterBlasFunctions(blas: ?*const BlasFunctions) void;
+extern fn _FortranAReferenceBlasFunctions() *const BlasFunctions;
+
+var reference_blas: *const BlasFunctions = undefined;
+var dgemm_calls: usize = 0;
+var dgemv_calls: usize = 0;
+var ddot_calls: usize = 0;
+
+fn countingDgemm(transa: [*c]const u8, transb: [*c]const u8, m: *const c_int, n: *const c_int, k: *const c_int, alpha: *const f64, a: [*c]const f64, lda: *const c_int, b: [*c]const f64, ldb: *const c_int, beta: *const f64, c: [*c]f64, ldc: *const c_int) callconv(.C) void {
+    dgemm_calls += 1;
+    reference_blas.dgemm.?(transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+fn countingDgemv(trans: [*c]const u8, m: *const c_int, n: *const c_int, alpha: *const f64, a: [*c]const f64, lda: *const c_int, x: [*c]const f64, incx: *const c_int, beta: *const f64, y: [*c]f64, incy: *const c_int) callconv(.C) void {
+    dgemv_calls += 1;
+    reference_blas.dgemv.?(trans, m, n, alpha, a, lda, x, incx, beta, y, incy);
+}
+
+fn countingDdot(n: *const c_int, x: [*c]const f64, incx: *const c_int, y: [*c]const f64, incy: *const c_int) callconv(.C) f64 {
+    ddot_calls += 1;
+    return reference_blas.ddot.?(n, x, incx, y, incy);
+}
+
+// Room for a descriptor of rank <= 2 without an addendum.
+const DescriptorStorage = [256]u8;
+
+fn establish(storage: *align(16) DescriptorStorage, base: ?*anyopaque, attribute: flang.CFI_attribute_t, extents: []const flang.CFI_index_t) !*flang.CFI_cdesc_t {
+    const desc: *flang.CFI_cdesc_t = @ptrCast(storage);
+    const status = flang.CFI_establish(
+        desc,
+        base,
+        attribute,
+        flang.CFI_type_double,
+        @sizeOf(f64),
+        @intCast(extents.len),
+        if (base == null) null else extents.ptr,
+    );
+    try std.testing.expectEqual(flang.CFI_SUCCESS, status);
+    return desc;
+}
+
+test "test_BLAS_dispatch" {
+    reference_blas = _FortranAReferenceBlasFunctions();
+    var counting = reference_blas.*;
+    counting.dgemm = &countingDgemm;
+    counting.dgemv = &countingDgemv;
+    counting.ddot = &countingDdot;
+    _FortranARegisterBlasFunctions(&counting);
+    defer _FortranARegisterBlasFunctions(null);
+
+    // X is 3x4 and Y is 4x2, column-major; V is the first column of Y.
+    var x: [12]f64 = undefined;
+    var y: [8]f64 = undefined;
+    for (&x, 0..) |*e, i| e.* = @floatFromInt(i + 1);
+    for (&y, 0..) |*e, i| e.* = @as(f64, @floatFromInt(i)) - 3.5;
+    var x_storage: DescriptorStorage align(16) = undefined;
+    var y_storage: DescriptorStorage align(16) = undefined;
+    var v_storage: DescriptorStorage align(16) = undefined;
+    var result_storage: DescriptorStorage align(16) = undefined;
+    const x_desc = try establish(&x_storage, &x, flang.CFI_attribute_other, &.{ 3, 4 });
+    const y_desc = try establish(&y_storage, &y, flang.CFI_attribute_other, &.{ 4, 2 });
+    const v_desc = try establish(&v_storage, &y, flang.CFI_attribute_other, &.{4});
+
+    // MATMUL(X, Y) goes to DGEMM, and MATMUL(X, V) to DGEMV.
+    for (0..2) |registered| {
+        if (registered == 1) _FortranARegisterBlasFunctions(null);
+        const result = try establish(&result_storage, null, flang.CFI_attribute_allocatable, &.{ 3, 2 });
+        _FortranAMatmulReal8Real8(result, x_desc, y_desc, null, 0);
+        var product = @as([*]f64, @ptrCast(@alignCast(result.base_addr)));
+        for (0..2) |j| {
+            for (0..3) |i| {
+                var expected: f64 = 0;
+                for (0..4) |l| expected += x[i + 3 * l] * y[l + 4 * j];
+                try std.testing.expectApproxEqAbs(expected, product[i + 3 * j], 1e-12);
+            }
+        }
+        try std.testing.expectEqual(flang.CFI_SUCCESS, flang.CFI_deallocate(result));
+
+        const vector_result = try establish(&result_storage, null, flang.CFI_attribute_allocatable, &.{3});
+        _FortranAMatmulReal8Real8(vector_result, x_desc, v_desc, null, 0);
+        product = @as([*]f64, @ptrCast(@alignCast(vector_result.base_addr)));
+        for (0..3) |i| {
+            var expected: f64 = 0;
+            for (0..4) |l| expected += x[i + 3 * l] * y[l];
+            try std.testing.expectApproxEqAbs(expected, product[i], 1e-12);
+        }
+        try std.testing.expectEqual(flang.CFI_SUCCESS, flang.CFI_deallocate(vector_result));
+
+        // DOT_PRODUCT(V, V) goes to DDOT.
+        var expected: f64 = 0;
+        for (0..4) |l| expected += y[l] * y[l];
+        try std.testing.expectApproxEqAbs(expected, _FortranADotProductReal8(v_desc, v_desc, null, 0), 1e-12);
+
+        // Nothing more reaches the table once it has been unregistered.
+        try std.testing.expectEqual(@as(usize, 1), dgemm_calls);
+        try std.testing.expectEqual(@as(usize, 1), dgemv_calls);
+        try std.testing.expectEqual(@as(usize, 1), ddot_calls);
+    }
+}
+
+// Derived type tests in derived.cpp, which build their type descriptions
+// in C++; each returns 0 or the line of its first failed check.
+extern fn test_initialized_component_allocatables() c_int;
+
+test "test_initialized_component_allocatables" {
+    try std.testing.expectEqual(@as(c_int, 0), test_initialized_component_allocatables());
+}
+
+extern fn test_initialization_image() c_int;
+
+test "test_initialization_image" {
+    try std.testing.expectEqual(@as(c_int, 0), test_initialization_image());
+}
+
+// Batched MATMUL tests in matmul.cpp; each returns 0 or the line of its
+// first failed check.
+extern fn test_batched_matmul() c_int;
+
+test "test_batched_matmul" {
+    try std.testing.expectEqual(@as(c_int, 0), test_batched_matmul());
+}
+
+extern fn test_batched_matmul_direct_checks() c_int;
+
+test "test_batched_matmul_direct_checks" {
+    try std.testing.expectEqual(@as(c_int, 0), test_batched_matmul_direct_checks());
+}
+
+// Reduction tests in reduction.cpp; each returns 0 or the line of its first
+// failed check.
+extern fn test_parallel_reductions_reproducible() c_int;
+
+test "test_parallel_reductions_reproducible" {
+    try std.testing.expectEqual(@as(c_int, 0), test_parallel_reductions_reproducible());
+}
+
+extern fn test_kahan_sum() c_int;
+
+test "test_kahan_sum" {
+    try std.testing.expectEqual(@as(c_int, 0), test_kahan_sum());
+}
+
+extern fn test_unordered_reduce() c_int;
+
+test "test_unordered_reduce" {
+    try std.testing.expectEqual(@as(c_int, 0), test_unordered_reduce());
+}
+
+extern fn test_unordered_reduce_character() c_int;
+
+test "test_unordered_reduce_character" {
+    try std.testing.expectEqual(@as(c_int, 0), test_unordered_reduce_character());
+}
+
+extern fn test_min_max_sum_norm2() c_int;
+
+test "test_min_max_sum_norm2" {
+    try std.testing.expectEqual(@as(c_int, 0), test_min_max_sum_norm2());
+}
+
+extern fn test_maxloc_minloc() c_int;
+
+test "test_maxloc_minloc" {
+    try std.testing.expectEqual(@as(c_int, 0), test_maxloc_minloc());
+}
+
+// Transformational intrinsic tests in transformational.cpp; each returns 0
+// or the line of its first failed check.
+extern fn test_pack_unpack() c_int;
+
+test "test_pack_unpack" {
+    try std.testing.expectEqual(@as(c_int, 0), test_pack_unpack());
+}
+
+extern fn test_cshift_eoshift() c_int;
+
+test "test_cshift_eoshift" {
+    try std.testing.expectEqual(@as(c_int, 0), test_cshift_eoshift());
+}
+
+extern fn test_reshape_view() c_int;
+
+test "test_reshape_view" {
+    try std.testing.expectEqual(@as(c_int, 0), test_reshape_view());
+}
+
+extern fn test_spread() c_int;
+
+test "test_spread" {
+    try std.testing.expectEqual(@as(c_int, 0), test_spread());
+}
+
+// Assignment tests in assign.cpp; each returns 0 or the line of its first
+// failed check.
+extern fn test_overlapping_vector_assignment() c_int;
+
+test "test_overlapping_vector_assignment" {
+    try std.testing.expectEqual(@as(c_int, 0), test_overlapping_vector_assignment());
+}
+
+extern fn test_overlapping_matrix_assignment() c_int;
+
+test "test_overlapping_matrix_assignment" {
+    try std.testing.expectEqual(@as(c_int, 0), test_overlapping_matrix_assignment());
+}
@@ -0,0 +1,504 @@
+//===-- tests/transformational.cpp ----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// Tests of transformational intrinsic functions against results computed
+// here element by element, called from tests.zig.  Each returns 0, or the
+// line number of the first failed check.
+
+#include "flang/Runtime/descriptor.h"
+#include "flang/Runtime/transformational.h"
+#include <cstdint>
+#include <vector>
+
+using namespace Fortran::runtime;
+using Fortran::common::TypeCategory;
+
+#define EXPECT(condition) \
+  if (!(condition)) { \
+    return __LINE__; \
+  }
+
+namespace {
+
+// Byte `b` of element `j` of a test array; `salt` tells the arrays apart.
+char Byte(SubscriptValue j, std::size_t b, int salt) {
+  return static_cast<char>(j * 7 + b * 3 + salt * 101);
+}
+
+// Establishes `desc` as a vector of `extent` CHARACTER(LEN=`bytes`)
+// elements `stride` elements apart in `storage`, so that any element size
+// can be tested, and fills in each element `j` from Byte(j, b, salt).
+void EstablishVector(Descriptor &desc, std::vector<char> &storage,
+    std::size_t bytes, SubscriptValue extent, int salt,
+    SubscriptValue stride = 1) {
+  storage.assign((extent > 0 ? extent * stride : 1) * bytes, 0);
+  for (SubscriptValue j{0}; j < extent; ++j) {
+    for (std::size_t b{0}; b < bytes; ++b) {
+      storage[j * stride * bytes + b] = Byte(j, b, salt);
+    }
+  }
+  desc.Establish(1, bytes, storage.data(), 1, &extent);
+  desc.GetDimension(0).SetBounds(1, extent).SetByteStride(stride * bytes);
+}
+
+// Whether element `k` of the contiguous `array` holds the bytes of element
+// `j` of the test array with `salt`.
+bool HasElement(
+    const Descriptor &array, SubscriptValue k, SubscriptValue j, int salt) {
+  const char *element{array.OffsetElement<char>(k * array.ElementBytes())};
+  for (std::size_t b{0}; b < array.ElementBytes(); ++b) {
+    if (element[b] != Byte(j, b, salt)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Establishes `desc` as a LOGICAL(1) MASK= of `extent` elements with the
+// values of isTrue(j); returns how many are true.
+SubscriptValue EstablishMask(Descriptor &desc,
+    std::vector<std::uint8_t> &storage, SubscriptValue extent,
+    bool (*isTrue)(SubscriptValue)) {
+  storage.assign(extent > 0 ? extent : 1, 0);
+  SubscriptValue trues{0};
+  for (SubscriptValue j{0}; j < extent; ++j) {
+    storage[j] = isTrue(j);
+    trues += isTrue(j);
+  }
+  desc.Establish(TypeCategory::Logical, 1, storage.data(), 1, &extent);
+  return trues;
+}
+
+// Masks that are all true or all false, and within a 64-bit word of the
+// packed mask alternating, mostly true, or sparse.
+bool AllTrue(SubscriptValue) { return true; }
+bool AllFalse(SubscriptValue) { return false; }
+bool Alternating(SubscriptValue j) { return j % 2 == 0; }
+bool MostlyTrue(SubscriptValue j) { return j % 5 != 0; }
+bool Sparse(SubscriptValue j) { return j % 17 == 3; }
+
+// PACK of `n` elements of `bytes` bytes apiece, `sourceStride` elements
+// apart, with the MASK= of isTrue(j), and with a VECTOR= of `vectorExtent`
+// elements unless that is negative.
+bool PackMatches(std::size_t bytes, SubscriptValue n,
+    bool (*isTrue)(SubscriptValue), SubscriptValue vectorExtent = -1,
+    SubscriptValue sourceStride = 1) {
+  std::vector<char> sourceStorage, vectorStorage;
+  std::vector<std::uint8_t> maskStorage;
+  StaticDescriptor<1> sourceStatic, maskStatic, vectorStatic, resultStatic;
+  Descriptor &source{sourceStatic.descriptor()};
+  Descriptor &mask{maskStatic.descriptor()};
+  Descriptor &vector{vectorStatic.descriptor()};
+  Descriptor &result{resultStatic.descriptor()};
+  EstablishVector(source, sourceStorage, bytes, n, 0, sourceStride);
+  SubscriptValue trues{EstablishMask(mask, maskStorage, n, isTrue)};
+  SubscriptValue extent{trues};
+  const Descriptor *optionalVector{nullptr};
+  if (vectorExtent >= 0) {
+    EstablishVector(vector, vectorStorage, bytes, vectorExtent, 1);
+    extent = vectorExtent;
+    optionalVector = &vector;
+  }
+  RTNAME(Pack)(result, source, mask, optionalVector, __FILE__, __LINE__);
+  bool same{result.rank() == 1 && result.ElementBytes() == bytes &&
+      result.GetDimension(0).Extent() == extent};
+  for (SubscriptValue j{0}, k{0}; same && j < n; ++j) {
+    if (isTrue(j)) {
+      same = HasElement(result, k++, j, 0);
+    }
+  }
+  for (SubscriptValue k{trues}; same && k < extent; ++k) {
+    same = HasElement(result, k, k, 1);
+  }
+  result.Deallocate();
+  return same;
+}
+
+// UNPACK into `n` elements of `bytes` bytes apiece from a VECTOR= of
+// `vectorExtent` elements `vectorStride` elements apart, with the MASK= of
+// isTrue(j), and with an array FIELD= or a scalar one.
+bool UnpackMatches(std::size_t bytes, SubscriptValue n,
+    bool (*isTrue)(SubscriptValue), SubscriptValue vectorExtent,
+    bool scalarField = false, SubscriptValue vectorStride = 1) {
+  std::vector<char> vectorStorage, fieldStorage;
+  std::vector<std::uint8_t> maskStorage;
+  StaticDescriptor<1> vectorStatic, maskStatic, fieldStatic, resultStatic;
+  Descriptor &vector{vectorStatic.descriptor()};
+  Descriptor &mask{maskStatic.descriptor()};
+  Descriptor &field{fieldStatic.descriptor()};
+  Descriptor &result{resultStatic.descriptor()};
+  EstablishVector(
+      vector, vectorStorage, bytes, vectorExtent, 1, vectorStride);
+  EstablishMask(mask, maskStorage, n, isTrue);
+  EstablishVector(field, fieldStorage, bytes, scalarField ? 1 : n, 2);
+  if (scalarField) {
+    field.Establish(1, bytes, fieldStorage.data(), 0);
+  }
+  RTNAME(Unpack)(result, vector, mask, field, __FILE__, __LINE__);
+  bool same{result.rank() == 1 && result.ElementBytes() == bytes &&
+      result.GetDimension(0).Extent() == n};
+  for (SubscriptValue j{0}, k{0}; same && j < n; ++j) {
+    same = isTrue(j) ? HasElement(result, j, k++, 1)
+                     : HasElement(result, j, scalarField ? 0 : j, 2);
+  }
+  result.Deallocate();
+  return same;
+}
+
+// The zero-based position along a section of `extent` elements that
+// CSHIFT (when `circular`) or EOSHIFT by `shift` moves to position `at`,
+// or -1 when EOSHIFT vacates it.
+SubscriptValue ShiftedFrom(bool circular, SubscriptValue at,
+    SubscriptValue shift, SubscriptValue extent) {
+  SubscriptValue from{at + shift};
+  if (circular) {
+    from %= extent;
+    return from < 0 ? from + extent : from;
+  }
+  return from >= 0 && from < extent ? from : -1;
+}
+
+// Element (i, j) of the INTEGER(4) SOURCE= of the shift tests.
+std::int32_t Value(SubscriptValue i, SubscriptValue j) {
+  return static_cast<std::int32_t>(100 * i + j + 1);
+}
+
+// CSHIFT (when `circular`) or EOSHIFT of a vector of `n` elements
+// Value(j, 0), `stride` elements apart, by `shift`; `boundary` has the
+// scalar BOUNDARY= of EOSHIFT, or nothing when that is absent.
+bool VectorShiftMatches(bool circular, SubscriptValue n, std::int64_t shift,
+    std::vector<std::int32_t> boundary = {}, SubscriptValue stride = 1) {
+  std::vector<std::int32_t> source(n > 0 ? n * stride : 1);
+  for (SubscriptValue j{0}; j < n; ++j) {
+    source[j * stride] = Value(j, 0);
+  }
+  StaticDescriptor<1> sourceStatic, boundaryStatic, resultStatic;
+  Descriptor &sourceDesc{sourceStatic.descriptor()};
+  Descriptor &boundaryDesc{boundaryStatic.descriptor()};
+  Descriptor &result{resultStatic.descriptor()};
+  sourceDesc.Establish(TypeCategory::Integer, 4, source.data(), 1, &n);
+  sourceDesc.GetDimension(0).SetByteStride(stride * sizeof source[0]);
+  if (circular) {
+    RTNAME(CshiftVector)(result, sourceDesc, shift, __FILE__, __LINE__);
+  } else {
+    const Descriptor *optionalBoundary{nullptr};
+    if (!boundary.empty()) {
+      boundaryDesc.Establish(TypeCategory::Integer, 4, boundary.data(), 0);
+      optionalBoundary = &boundaryDesc;
+    }
+    RTNAME(EoshiftVector)
+    (result, sourceDesc, shift, optionalBoundary, __FILE__, __LINE__);
+  }
+  bool same{result.rank() == 1 && result.GetDimension(0).Extent() == n};
+  for (SubscriptValue j{0}; same && j < n; ++j) {
+    SubscriptValue from{ShiftedFrom(circular, j, shift, n)};
+    same = result.OffsetElement<std::int32_t>()[j] ==
+        (from >= 0 ? Value(from, 0) : boundary.empty() ? 0 : boundary[0]);
+  }
+  result.Deallocate();
+  return same;
+}
+
+// CSHIFT (when `circular`) or EOSHIFT along DIM=`dim` of the rows x columns
+// matrix of elements Value(i, j), which is every `rowStep`-th row of a
+// taller one.  `shifts` has the count of a scalar SHIFT=, or one for each
+// section along DIM=; `boundaries` likewise has the BOUNDARY= of EOSHIFT,
+// or nothing when that is absent.
+bool ShiftMatches(bool circular, SubscriptValue rows, SubscriptValue columns,
+    int dim, std::vector<std::int32_t> shifts,
+    std::vector<std::int32_t> boundaries = {}, SubscriptValue rowStep = 1) {
+  std::vector<std::int32_t> source(rows * rowStep * columns);
+  for (SubscriptValue j{0}; j < columns; ++j) {
+    for (SubscriptValue i{0}; i < rows; ++i) {
+      source[(i + j * rows) * rowStep] = Value(i, j);
+    }
+  }
+  StaticDescriptor<2> sourceStatic, shiftStatic, boundaryStatic, resultStatic;
+  Descriptor &sourceDesc{sourceStatic.descriptor()};
+  Descriptor &shiftDesc{shiftStatic.descriptor()};
+  Descriptor &boundaryDesc{boundaryStatic.descriptor()};
+  Descriptor &result{resultStatic.descriptor()};
+  SubscriptValue extent[2]{rows, columns};
+  sourceDesc.Establish(TypeCategory::Integer, 4, source.data(), 2, extent);
+  sourceDesc.GetDimension(0).SetByteStride(rowStep * sizeof source[0]);
+  sourceDesc.GetDimension(1).SetByteStride(rows * rowStep * sizeof source[0]);
+  SubscriptValue sections{dim == 1 ? columns : rows};
+  shiftDesc.Establish(TypeCategory::Integer, 4, shifts.data(),
+      shifts.size() == 1 ? 0 : 1, &sections);
+  if (circular) {
+    RTNAME(Cshift)(result, sourceDesc, shiftDesc, dim, __FILE__, __LINE__);
+  } else {
+    const Descriptor *optionalBoundary{nullptr};
+    if (!boundaries.empty()) {
+      boundaryDesc.Establish(TypeCategory::Integer, 4, boundaries.data(),
+          boundaries.size() == 1 ? 0 : 1, &sections);
+      optionalBoundary = &boundaryDesc;
+    }
+    RTNAME(Eoshift)
+    (result, sourceDesc, shiftDesc, optionalBoundary, dim, __FILE__,
+        __LINE__);
+  }
+  bool same{result.rank() == 2 && result.GetDimension(0).Extent() == rows &&
+      result.GetDimension(1).Extent() == columns};
+  for (SubscriptValue j{0}; same && j < columns; ++j) {
+    for (SubscriptValue i{0}; same && i < rows; ++i) {
+      SubscriptValue section{dim == 1 ? j : i};
+      SubscriptValue shift{shifts[shifts.size() == 1 ? 0 : section]};
+      SubscriptValue from{dim == 1
+              ? ShiftedFrom(circular, i, shift, rows)
+              : ShiftedFrom(circular, j, shift, columns)};
+      std::int32_t expected{0};
+      if (from >= 0) {
+        expected = dim == 1 ? Value(from, j) : Value(i, from);
+      } else if (!boundaries.empty()) {
+        expected = boundaries[boundaries.size() == 1 ? 0 : section];
+      }
+      same = result.OffsetElement<std::int32_t>()[i + j * rows] == expected;
+    }
+  }
+  result.Deallocate();
+  return same;
+}
+
+// SPREAD along DIM=`dim` with NCOPIES=`ncopies` of an INTEGER(4) SOURCE=
+// of `rank` 0, 1 or 2 whose elements are Value(i, j) of a 3 x 4 matrix,
+// which is every `rowStep`-th row of a taller one.
+bool SpreadMatches(
+    int rank, int dim, std::int64_t ncopies, SubscriptValue rowStep = 1) {
+  SubscriptValue sourceExtent[2]{3, 4};
+  std::vector<std::int32_t> source(3 * rowStep * 4);
+  for (SubscriptValue j{0}; j < 4; ++j) {
+    for (SubscriptValue i{0}; i < 3; ++i) {
+      source[(i + j * 3) * rowStep] = Value(i, j);
+    }
+  }
+  StaticDescriptor<2> sourceStatic;
+  StaticDescriptor<3> resultStatic;
+  Descriptor &sourceDesc{sourceStatic.descriptor()};
+  Descriptor &result{resultStatic.descriptor()};
+  sourceDesc.Establish(
+      TypeCategory::Integer, 4, source.data(), rank, sourceExtent);
+  for (int j{0}; j < rank; ++j) {
+    sourceDesc.GetDimension(j).SetByteStride(
+        (j == 0 ? 1 : 3) * rowStep * sizeof source[0]);
+  }
+  RTNAME(Spread)(result, sourceDesc, dim, ncopies, __FILE__, __LINE__);
+  SubscriptValue copies{ncopies > 0 ? ncopies : 0};
+  SubscriptValue extent[3];
+  std::size_t elements{1};
+  for (int j{0}, k{0}; j <= rank; ++j) {
+    extent[j] = j == dim - 1 ? copies : sourceExtent[k++];
+    elements *= extent[j];
+  }
+  bool same{result.rank() == rank + 1};
+  for (int j{0}; same && j <= rank; ++j) {
+    same = result.GetDimension(j).Extent() == extent[j];
+  }
+  for (std::size_t n{0}; same && n < elements; ++n) {
+    // The subscripts of the n-th element of the result, less DIM=, are
+    // those of its SOURCE= element.
+    SubscriptValue at[2]{0, 0};
+    SubscriptValue rest{static_cast<SubscriptValue>(n)};
+    for (int j{0}, k{0}; j <= rank; ++j) {
+      if (j != dim - 1) {
+        at[k++] = rest % extent[j];
+      }
+      rest /= extent[j];
+    }
+    same = result.OffsetElement<std::int32_t>()[n] == Value(at[0], at[1]);
+  }
+  result.Deallocate();
+  return same;
+}
+
+// RESHAPE through ReshapeView() of a vector of the REAL(8) values 1 to `n`,
+// every `stride`-th element of a longer one, to `shape`, with PAD= and
+// ORDER= unless they are empty.  Checks whether the result is a view of
+// SOURCE=, and compares its elements with the RESHAPE done here, and after
+// CopyReshapeView() with the result of Reshape().
+bool ReshapeViewMatches(bool expectView, SubscriptValue n,
+    std::vector<std::int32_t> shape, std::vector<double> pad = {},
+    std::vector<std::int32_t> order = {}, SubscriptValue stride = 1) {
+  std::vector<double> source(n * stride);
+  for (SubscriptValue j{0}; j < n; ++j) {
+    source[j * stride] = j + 1;
+  }
+  StaticDescriptor<1> sourceStatic, shapeStatic, padStatic, orderStatic;
+  StaticDescriptor<maxRank> resultStatic, copyStatic;
+  Descriptor &sourceDesc{sourceStatic.descriptor()};
+  Descriptor &shapeDesc{shapeStatic.descriptor()};
+  Descriptor &padDesc{padStatic.descriptor()};
+  Descriptor &orderDesc{orderStatic.descriptor()};
+  Descriptor &result{resultStatic.descriptor()};
+  Descriptor &copy{copyStatic.descriptor()};
+  sourceDesc.Establish(TypeCategory::Real, 8, source.data(), 1, &n);
+  sourceDesc.GetDimension(0).SetByteStride(stride * sizeof source[0]);
+  auto rank{static_cast<SubscriptValue>(shape.size())};
+  shapeDesc.Establish(TypeCategory::Integer, 4, shape.data(), 1, &rank);
+  const Descriptor *optionalPad{nullptr}, *optionalOrder{nullptr};
+  if (!pad.empty()) {
+    auto padExtent{static_cast<SubscriptValue>(pad.size())};
+    padDesc.Establish(TypeCategory::Real, 8, pad.data(), 1, &padExtent);
+    optionalPad = &padDesc;
+  }
+  if (!order.empty()) {
+    orderDesc.Establish(TypeCategory::Integer, 4, order.data(), 1, &rank);
+    optionalOrder = &orderDesc;
+  }
+  bool isView{RTNAME(ReshapeView)(result, sourceDesc, shapeDesc, optionalPad,
+      optionalOrder, __FILE__, __LINE__)};
+  bool same{isView == expectView && result.rank() == rank &&
+      result.raw().attribute ==
+          (isView ? CFI_attribute_pointer : CFI_attribute_allocatable) &&
+      (result.OffsetElement<double>() == source.data()) == isView};
+  // The elements of the result in array element order.
+  std::size_t elements{1};
+  for (int j{0}; j < rank; ++j) {
+    same &= result.GetDimension(j).Extent() == shape[j];
+    elements *= shape[j];
+  }
+  std::vector<double> expected(elements);
+  SubscriptValue at[maxRank]{}; // zero-based, advanced in ORDER= order
+  for (std::size_t k{0}; k < elements; ++k) {
+    SubscriptValue offset{0}, dimElements{1};
+    for (int j{0}; j < rank; ++j) {
+      offset += at[j] * dimElements;
+      dimElements *= shape[j];
+    }
+    expected[offset] = static_cast<SubscriptValue>(k) < n
+        ? k + 1
+        : pad[(k - n) % pad.size()];
+    for (int j{0}; j < rank; ++j) {
+      int dim{order.empty() ? j : order[j] - 1};
+      if (++at[dim] < shape[dim]) {
+        break;
+      }
+      at[dim] = 0;
+    }
+  }
+  for (std::size_t k{0}; same && k < elements; ++k) {
+    same = result.OffsetElement<double>()[k] == expected[k];
+  }
+  RTNAME(Reshape)
+  (copy, sourceDesc, shapeDesc, optionalPad, optionalOrder, __FILE__,
+      __LINE__);
+  RTNAME(CopyReshapeView)(result, __FILE__, __LINE__);
+  same &= result.raw().attribute == CFI_attribute_allocatable &&
+      result.OffsetElement<double>() != source.data() && result.rank() == rank;
+  // The copy no longer depends on SOURCE=.
+  for (double &x : source) {
+    x = -x;
+  }
+  for (std::size_t k{0}; same && k < elements; ++k) {
+    same = result.OffsetElement<double>()[k] == expected[k] &&
+        copy.OffsetElement<double>()[k] == expected[k];
+  }
+  result.Deallocate();
+  copy.Deallocate();
+  return same;
+}
+
+} // namespace
+
+extern "C" {
+
+int test_pack_unpack() {
+  // The sizes compressed and expanded one word of the mask at a time, and
+  // two that are copied element by element.
+  for (std::size_t bytes : {1, 2, 4, 8, 16, 3, 10}) {
+    for (auto *isTrue : {AllTrue, AllFalse, Alternating, MostlyTrue, Sparse}) {
+      // Two full words of the mask and a partial one, and one full word.
+      for (SubscriptValue n : {150, 64}) {
+        EXPECT(PackMatches(bytes, n, isTrue));
+        EXPECT(PackMatches(bytes, n, isTrue, n + 5));
+        EXPECT(PackMatches(bytes, n, isTrue, -1, 3));
+        EXPECT(UnpackMatches(bytes, n, isTrue, n + 5));
+        EXPECT(UnpackMatches(bytes, n, isTrue, n, true));
+        EXPECT(UnpackMatches(bytes, n, isTrue, n, false, 2));
+      }
+    }
+    EXPECT(PackMatches(bytes, 0, AllTrue));
+    EXPECT(PackMatches(bytes, 0, AllTrue, 4));
+    EXPECT(UnpackMatches(bytes, 0, AllTrue, 0));
+  }
+  return 0;
+}
+
+int test_cshift_eoshift() {
+  // Vectors, with shifts of either sign that are within the extent, equal
+  // to it, and beyond it.
+  for (std::int64_t shift : {0, 3, -3, 10, -10, 13, -27}) {
+    for (SubscriptValue stride : {1, 2}) {
+      EXPECT(VectorShiftMatches(true, 10, shift, {}, stride));
+      EXPECT(VectorShiftMatches(false, 10, shift, {}, stride));
+      EXPECT(VectorShiftMatches(false, 10, shift, {-7}, stride));
+    }
+    EXPECT(VectorShiftMatches(true, 1, shift));
+    EXPECT(VectorShiftMatches(false, 0, shift, {-7}));
+  }
+  // Matrices along each dimension, contiguous or not, with a scalar SHIFT=
+  // and BOUNDARY=, and with one for each section.
+  for (int dim : {1, 2}) {
+    std::vector<std::int32_t> shifts{dim == 1
+            ? std::vector<std::int32_t>{0, 1, -1, 5, -6, 12, 3}
+            : std::vector<std::int32_t>{2, -2, 7, -8, 0}};
+    std::vector<std::int32_t> boundaries(shifts.size());
+    for (std::size_t k{0}; k < boundaries.size(); ++k) {
+      boundaries[k] = -1000 - static_cast<std::int32_t>(k);
+    }
+    for (SubscriptValue rowStep : {1, 2}) {
+      for (std::int32_t shift : {0, 2, -3, 9, -12}) {
+        EXPECT(ShiftMatches(true, 5, 7, dim, {shift}, {}, rowStep));
+        EXPECT(ShiftMatches(false, 5, 7, dim, {shift}, {}, rowStep));
+        EXPECT(ShiftMatches(false, 5, 7, dim, {shift}, {-1}, rowStep));
+        EXPECT(ShiftMatches(false, 5, 7, dim, {shift}, boundaries, rowStep));
+      }
+      EXPECT(ShiftMatches(true, 5, 7, dim, shifts, {}, rowStep));
+      EXPECT(ShiftMatches(false, 5, 7, dim, shifts, {}, rowStep));
+      EXPECT(ShiftMatches(false, 5, 7, dim, shifts, {-1}, rowStep));
+      EXPECT(ShiftMatches(false, 5, 7, dim, shifts, boundaries, rowStep));
+    }
+  }
+  return 0;
+}
+
+int test_reshape_view() {
+  // A contiguous SOURCE= in the same storage sequence is viewed, whether
+  // it is used up or not, and even with a PAD= that is not needed.
+  EXPECT(ReshapeViewMatches(true, 24, {4, 6}));
+  EXPECT(ReshapeViewMatches(true, 24, {2, 3, 4}));
+  EXPECT(ReshapeViewMatches(true, 24, {24}));
+  EXPECT(ReshapeViewMatches(true, 24, {3, 5}));
+  EXPECT(ReshapeViewMatches(true, 24, {0, 5}));
+  EXPECT(ReshapeViewMatches(true, 24, {4, 6}, {-1}));
+  EXPECT(ReshapeViewMatches(true, 24, {2, 3, 4}, {}, {1, 2, 3}));
+  // Otherwise the result is a copy: of a SOURCE= that is not contiguous,
+  // with PAD= needed, and with ORDER= that is not the identity.
+  EXPECT(ReshapeViewMatches(false, 24, {4, 6}, {}, {}, 2));
+  EXPECT(ReshapeViewMatches(false, 24, {5, 6}, {-1, -2, -3}));
+  EXPECT(ReshapeViewMatches(false, 24, {4, 6}, {}, {2, 1}));
+  EXPECT(ReshapeViewMatches(false, 24, {2, 3, 4}, {}, {3, 1, 2}));
+  EXPECT(ReshapeViewMatches(false, 10, {3, 5}, {-1, -2}, {2, 1}, 3));
+  return 0;
+}
+
+int test_spread() {
+  for (int rank{0}; rank <= 2; ++rank) {
+    for (int dim{1}; dim <= rank + 1; ++dim) {
+      // No copies, one, and counts of copies that are not powers of two,
+      // so that the copies are not all done by doubling.
+      for (std::int64_t ncopies : {-2, 0, 1, 2, 7}) {
+        EXPECT(SpreadMatches(rank, dim, ncopies));
+        EXPECT(SpreadMatches(rank, dim, ncopies, 2));
+      }
+    }
+  }
+  return 0;
+}
+
+} // extern "C"